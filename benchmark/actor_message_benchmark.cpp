@@ -0,0 +1,96 @@
+/**
+ * actor_message_benchmark.cpp
+ * @author wherewindblow
+ * @date   Mar 28, 2019
+ * @note Measures throughput of actor message queue when multiple producers push to one consumer.
+ */
+
+#include <cstdint>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <iostream>
+
+#include <lights/format.h>
+#include <lights/precise_time.h>
+#include <foundation/actor_message.h>
+
+
+using spaceless::ActorMessage;
+using spaceless::ActorMessageQueue;
+
+const std::size_t MESSAGE_PER_PRODUCER = 2000000;
+const std::size_t CONSUMER_BATCH_COUNT = 64;
+const int PRODUCER_NUM_LIST[] = {1, 2, 4, 8};
+
+
+/**
+ * Pushes messages by @c producer_num threads and pops them by current thread, and then prints throughput.
+ * Producers wait for space when lane is full, so full queue is also measured.
+ */
+void run_case(int producer_num)
+{
+	auto queue = ActorMessageQueue::instance();
+	std::size_t total_count = MESSAGE_PER_PRODUCER * static_cast<std::size_t>(producer_num);
+	std::atomic<bool> is_started(false);
+
+	std::vector<std::thread> producer_list;
+	for (int i = 0; i < producer_num; ++i)
+	{
+		producer_list.emplace_back([queue, &is_started]()
+		{
+			while (!is_started.load(std::memory_order_acquire))
+			{
+				std::this_thread::yield();
+			}
+
+			ActorMessage msg;
+			for (std::size_t n = 0; n < MESSAGE_PER_PRODUCER; ++n)
+			{
+				msg.network_msg.package_id = static_cast<int>(n);
+				queue->push(ActorMessageQueue::IN_QUEUE, msg);
+			}
+		});
+	}
+
+	std::int64_t start_us = lights::to_microsecond(lights::current_monotonic_time());
+	is_started.store(true, std::memory_order_release);
+
+	ActorMessage msg_list[CONSUMER_BATCH_COUNT];
+	std::size_t pop_count = 0;
+	std::size_t empty_count = 0;
+	while (pop_count < total_count)
+	{
+		std::size_t count = queue->pop(ActorMessageQueue::IN_QUEUE, msg_list, CONSUMER_BATCH_COUNT);
+		if (count == 0)
+		{
+			++empty_count;
+			std::this_thread::yield();
+		}
+		pop_count += count;
+	}
+	std::int64_t used_us = lights::to_microsecond(lights::current_monotonic_time()) - start_us;
+
+	for (auto& producer : producer_list)
+	{
+		producer.join();
+	}
+
+	double msg_per_sec = used_us == 0 ? 0 : static_cast<double>(total_count) * 1000000 / used_us;
+	double ns_per_msg = static_cast<double>(used_us) * 1000 / total_count;
+	std::cout << lights::format("producer_num={} throughput={}msg/s latency={}ns/msg empty_pop={}\n",
+								producer_num,
+								static_cast<std::int64_t>(msg_per_sec),
+								static_cast<std::int64_t>(ns_per_msg),
+								empty_count);
+}
+
+
+int main()
+{
+	for (int producer_num : PRODUCER_NUM_LIST)
+	{
+		run_case(producer_num);
+	}
+	return 0;
+}
@@ -0,0 +1,84 @@
+/**
+ * crypto_benchmark.cpp
+ * @author wherewindblow
+ * @date   Mar 28, 2019
+ * @note Measures throughput of package cipher of secure connection.
+ */
+
+#include <cstdint>
+#include <vector>
+#include <iostream>
+
+#include <lights/format.h>
+#include <lights/precise_time.h>
+#include <crypto/aes.h>
+#include <foundation/package.h>
+
+
+using spaceless::crypto::AesKey;
+using spaceless::crypto::AesKeyBits;
+
+const std::size_t TOTAL_LENGTH = 256 * 1024 * 1024; // Length of data that encrypted by each case.
+const std::size_t PACKAGE_LENGTH_LIST[] = {256, 4096, 65536};
+
+
+/**
+ * Runs @c process on package buffer until processing total length and prints throughput.
+ */
+template <typename Process>
+void run_case(const char* name, std::size_t package_len, Process process)
+{
+	std::vector<char> package(package_len + spaceless::crypto::AES_GCM_TAG_SIZE, 'a');
+	std::size_t times = TOTAL_LENGTH / package_len;
+
+	std::int64_t start_us = lights::to_microsecond(lights::current_monotonic_time());
+	for (std::size_t i = 0; i < times; ++i)
+	{
+		process(package.data(), package_len, i);
+	}
+	std::int64_t used_us = lights::to_microsecond(lights::current_monotonic_time()) - start_us;
+
+	double mb = static_cast<double>(times * package_len) / (1024 * 1024);
+	double mb_per_sec = used_us == 0 ? 0 : mb * 1000000 / used_us;
+	std::cout << lights::format("{} package_length={} throughput={}MB/s\n",
+								name, package_len, static_cast<std::int64_t>(mb_per_sec));
+}
+
+
+int main()
+{
+	AesKey key(AesKeyBits::BITS_256);
+
+	for (std::size_t package_len : PACKAGE_LENGTH_LIST)
+	{
+		// Cipher that used before GCM. Each block is processed by one call.
+		spaceless::crypto::AesBlockEncryptor block_encryptor;
+		block_encryptor.set_key(key);
+		run_case("aes_ecb_block", package_len, [&](char* data, std::size_t len, std::size_t)
+		{
+			for (std::size_t i = 0; i + spaceless::crypto::AES_BLOCK_SIZE <= len; i += spaceless::crypto::AES_BLOCK_SIZE)
+			{
+				block_encryptor.encrypt(data + i);
+			}
+		});
+
+		// Same operations as secure connection sends a package.
+		spaceless::crypto::AesGcmEncryptor gcm_encryptor;
+		gcm_encryptor.set_key(key);
+		char header[sizeof(spaceless::PackageHeader)] = {};
+		run_case("aes_gcm_encrypt", package_len, [&](char* data, std::size_t len, std::size_t sequence)
+		{
+			spaceless::crypto::AesGcmIv iv;
+			iv.fill(0);
+			for (std::size_t i = 0; i < sizeof(std::uint64_t); ++i)
+			{
+				iv[iv.size() - 1 - i] = static_cast<spaceless::crypto::byte>(sequence >> (i * 8));
+			}
+			gcm_encryptor.start(iv);
+			gcm_encryptor.authenticate(header, sizeof(header));
+			gcm_encryptor.encrypt(data, len);
+			gcm_encryptor.finish(data + len);
+		});
+	}
+	return 0;
+}
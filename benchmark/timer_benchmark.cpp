@@ -0,0 +1,136 @@
+/**
+ * timer_benchmark.cpp
+ * @author wherewindblow
+ * @date   Mar 28, 2019
+ * @note Measures timing wheel with one million timers and cost of reading clock of timer.
+ */
+
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <iostream>
+
+#include <lights/format.h>
+#include <lights/precise_time.h>
+#include <foundation/timing_wheel.h>
+
+
+const std::size_t TIMER_NUM = 1000000;
+const std::uint64_t MAX_EXPIRY_TICK = 60000; // One minute when tick is one millisecond.
+const std::size_t CLOCK_READ_TIMES = 10000000;
+
+// Same value type as timer of worker, so moving node costs the same.
+using TimerWheel = spaceless::TimingWheel<std::function<void()>>;
+
+
+/**
+ * Returns monotonic time in nanosecond.
+ */
+std::int64_t now_ns()
+{
+	lights::PreciseTime time = lights::current_monotonic_time();
+	return time.seconds * 1000000000 + time.nanoseconds;
+}
+
+
+/**
+ * Prints cost of each operation.
+ */
+void print_result(const char* name, std::size_t count, std::int64_t used_ns)
+{
+	std::cout << lights::format("{} count={} total={}ms cost={}ns/op\n",
+								name, count, used_ns / 1000000, used_ns / static_cast<std::int64_t>(count));
+}
+
+
+/**
+ * Adds timers that expiry at random tick.
+ */
+std::vector<TimerWheel::Handle> add_timer(TimerWheel& wheel, const std::vector<std::uint64_t>& expiry_list)
+{
+	std::vector<TimerWheel::Handle> handle_list;
+	handle_list.reserve(expiry_list.size());
+	std::int64_t start_ns = now_ns();
+	for (std::uint64_t expiry_tick : expiry_list)
+	{
+		handle_list.push_back(wheel.add(expiry_tick, []() {}));
+	}
+	print_result("add", expiry_list.size(), now_ns() - start_ns);
+	return handle_list;
+}
+
+
+int main()
+{
+	std::mt19937_64 engine(1);
+	std::uniform_int_distribution<std::uint64_t> distribution(1, MAX_EXPIRY_TICK);
+	std::vector<std::uint64_t> expiry_list(TIMER_NUM);
+	for (auto& expiry_tick : expiry_list)
+	{
+		expiry_tick = distribution(engine);
+	}
+
+	// Adds timers and expires all of them tick by tick, as worker advances one tick each loop.
+	{
+		TimerWheel wheel;
+		add_timer(wheel, expiry_list);
+		std::size_t expiry_count = 0;
+		std::int64_t start_ns = now_ns();
+		for (std::uint64_t tick = 1; tick <= MAX_EXPIRY_TICK; ++tick)
+		{
+			expiry_count += wheel.advance(tick, [](TimerWheel::Handle) {});
+		}
+		print_result("advance_and_expiry", expiry_count, now_ns() - start_ns);
+	}
+
+	// Adds timers and removes them in random order, as most timeout timers are removed before expiry.
+	{
+		TimerWheel wheel;
+		std::vector<TimerWheel::Handle> handle_list = add_timer(wheel, expiry_list);
+		std::shuffle(handle_list.begin(), handle_list.end(), engine);
+		std::int64_t start_ns = now_ns();
+		for (TimerWheel::Handle handle : handle_list)
+		{
+			wheel.remove(handle);
+		}
+		print_result("remove", handle_list.size(), now_ns() - start_ns);
+	}
+
+	// Frequent timers are rearmed by every expiry.
+	{
+		TimerWheel wheel;
+		add_timer(wheel, expiry_list);
+		std::size_t expiry_count = 0;
+		std::int64_t start_ns = now_ns();
+		for (std::uint64_t tick = 1; tick <= MAX_EXPIRY_TICK; ++tick)
+		{
+			expiry_count += wheel.advance(tick, [&wheel, tick](TimerWheel::Handle handle)
+			{
+				wheel.rearm(handle, tick + MAX_EXPIRY_TICK);
+			});
+		}
+		print_result("advance_and_rearm", expiry_count, now_ns() - start_ns);
+	}
+
+	// Timer reads clock when register timer and each loop of worker.
+	{
+		std::int64_t sum = 0;
+		std::int64_t start_ns = now_ns();
+		for (std::size_t i = 0; i < CLOCK_READ_TIMES; ++i)
+		{
+			sum += lights::current_monotonic_time().nanoseconds;
+		}
+		print_result("monotonic_clock", CLOCK_READ_TIMES, now_ns() - start_ns);
+
+		start_ns = now_ns();
+		for (std::size_t i = 0; i < CLOCK_READ_TIMES; ++i)
+		{
+			sum += lights::current_coarse_monotonic_time().nanoseconds;
+		}
+		print_result("coarse_monotonic_clock", CLOCK_READ_TIMES, now_ns() - start_ns);
+		std::cout << lights::format("checksum={}\n", sum & 1);
+	}
+	return 0;
+}
@@ -9,6 +9,7 @@
 
 #include <cmath>
 #include <fstream>
+#include <algorithm>
 
 #include <lights/file.h>
 
@@ -24,15 +25,74 @@ int conn_id = 0;
 
 const int HEARTBEAT_PER_SEC = 50;
 
+const int PUT_FRAGMENT_MAX_RETRY = 3;
+
 const std::string META_FILE_PREFIX = ".meta";
 
 
+void BatchManager::start_batch()
+{
+	m_is_batching = true;
+}
+
+
+void BatchManager::send_batch()
+{
+	m_is_batching = false;
+	flush();
+}
+
+
+bool BatchManager::is_batching() const
+{
+	return m_is_batching;
+}
+
+
+void BatchManager::send_request(const protocol::Message& request)
+{
+	if (!m_is_batching)
+	{
+		Network::send_protocol(conn_id, request);
+		return;
+	}
+
+	Entry entry;
+	entry.command = protocol::get_command(request);
+	request.SerializeToString(&entry.content);
+	m_entry_list.push_back(std::move(entry));
+	if (static_cast<int>(m_entry_list.size()) >= BATCH_MAX_ENTRY_NUM)
+	{
+		flush();
+	}
+}
+
+
+void BatchManager::flush()
+{
+	if (m_entry_list.empty())
+	{
+		return;
+	}
+
+	protocol::ReqBatch request;
+	for (auto& entry : m_entry_list)
+	{
+		protocol::BatchEntry* batch_entry = request.add_entry_list();
+		batch_entry->set_command(entry.command);
+		batch_entry->set_content(std::move(entry.content));
+	}
+	m_entry_list.clear();
+	Network::send_protocol(conn_id, request);
+}
+
+
 void UserManager::register_user(const std::string& username, const std::string& password)
 {
 	protocol::ReqRegisterUser request;
 	request.set_username(username);
 	request.set_password(password);
-	Network::send_protocol(conn_id, request);
+	BatchManager::instance()->send_request(request);
 }
 
 
@@ -41,7 +101,7 @@ void UserManager::login_user(int user_id, const std::string& password)
 	protocol::ReqLoginUser request;
 	request.set_user_id(user_id);
 	request.set_password(password);
-	Network::send_protocol(conn_id, request);
+	BatchManager::instance()->send_request(request);
 }
 
 
@@ -49,7 +109,7 @@ void UserManager::remove_user(int user_id)
 {
 	protocol::ReqRemoveUser request;
 	request.set_user_id(user_id);
-	Network::send_protocol(conn_id, request);
+	BatchManager::instance()->send_request(request);
 }
 
 
@@ -57,7 +117,7 @@ void UserManager::find_user(int user_id)
 {
 	protocol::ReqFindUser request;
 	request.set_user_id(user_id);
-	Network::send_protocol(conn_id, request);
+	BatchManager::instance()->send_request(request);
 }
 
 
@@ -65,7 +125,7 @@ void UserManager::find_user(const std::string& username)
 {
 	protocol::ReqFindUser request;
 	request.set_username(username);
-	Network::send_protocol(conn_id, request);
+	BatchManager::instance()->send_request(request);
 }
 
 
@@ -73,7 +133,7 @@ void SharingGroupManager::register_group(const std::string& group_name)
 {
 	protocol::ReqRegisterGroup request;
 	request.set_group_name(group_name);
-	Network::send_protocol(conn_id, request);
+	BatchManager::instance()->send_request(request);
 }
 
 
@@ -81,7 +141,7 @@ void SharingGroupManager::remove_group(int group_id)
 {
 	protocol::ReqRemoveGroup request;
 	request.set_group_id(group_id);
-	Network::send_protocol(conn_id, request);
+	BatchManager::instance()->send_request(request);
 }
 
 
@@ -89,7 +149,7 @@ void SharingGroupManager::find_group(int group_id)
 {
 	protocol::ReqFindGroup request;
 	request.set_group_id(group_id);
-	Network::send_protocol(conn_id, request);
+	BatchManager::instance()->send_request(request);
 }
 
 
@@ -97,7 +157,7 @@ void SharingGroupManager::find_group(const std::string& group_name)
 {
 	protocol::ReqFindGroup request;
 	request.set_group_name(group_name);
-	Network::send_protocol(conn_id, request);
+	BatchManager::instance()->send_request(request);
 }
 
 
@@ -105,7 +165,7 @@ void SharingGroupManager::join_group(int group_id)
 {
 	protocol::ReqJoinGroup request;
 	request.set_group_id(group_id);
-	Network::send_protocol(conn_id, request);
+	BatchManager::instance()->send_request(request);
 }
 
 
@@ -114,7 +174,7 @@ void SharingGroupManager::assign_as_manager(int group_id, int user_id)
 	protocol::ReqAssignAsManager request;
 	request.set_group_id(group_id);
 	request.set_user_id(user_id);
-	Network::send_protocol(conn_id, request);
+	BatchManager::instance()->send_request(request);
 }
 
 
@@ -123,7 +183,7 @@ void SharingGroupManager::assign_as_member(int group_id, int user_id)
 	protocol::ReqAssignAsMember request;
 	request.set_group_id(group_id);
 	request.set_user_id(user_id);
-	Network::send_protocol(conn_id, request);
+	BatchManager::instance()->send_request(request);
 }
 
 
@@ -132,7 +192,7 @@ void SharingGroupManager::kick_out_user(int group_id, int user_id)
 	protocol::ReqKickOutUser request;
 	request.set_group_id(group_id);
 	request.set_user_id(user_id);
-	Network::send_protocol(conn_id, request);
+	BatchManager::instance()->send_request(request);
 }
 
 
@@ -141,7 +201,7 @@ void SharingFileManager::list_file(int group_id, const std::string& file_path)
 	protocol::ReqListFile request;
 	request.set_group_id(group_id);
 	request.set_file_path(file_path);
-	Network::send_protocol(conn_id, request);
+	BatchManager::instance()->send_request(request);
 }
 
 
@@ -150,11 +210,13 @@ void SharingFileManager::put_file(int group_id, const std::string& local_path, c
 	m_put_session.local_path = local_path;
 	m_put_session.group_id = group_id;
 	m_put_session.remote_path = remote_path;
-	m_put_session.start_time = lights::current_precise_time();
+	m_put_session.start_time = lights::current_monotonic_time();
+	m_put_session.fragment_state.clear();
+	m_put_session.fragment_retry_count.clear();
 
 	lights::FileStream file(local_path, "r");
 	float file_size = static_cast<float>(file.size());
-	int max_fragment = static_cast<int>(std::ceil(file_size / protocol::MAX_FRAGMENT_CONTENT_LEN));
+	int max_fragment = static_cast<int>(std::ceil(file_size / static_cast<float>(protocol::MAX_FRAGMENT_CONTENT_LEN)));
 	m_put_session.max_fragment = max_fragment;
 
 	protocol::ReqPutFileSession request;
@@ -165,22 +227,71 @@ void SharingFileManager::put_file(int group_id, const std::string& local_path, c
 }
 
 
-void SharingFileManager::start_put_file(int next_fragment)
+void SharingFileManager::start_put_file(int next_fragment, int window_size)
 {
-	lights::FileStream file(m_put_session.local_path, "r");
-	for (int fragment_index = next_fragment; fragment_index < m_put_session.max_fragment; ++fragment_index)
+	m_put_session.fragment_index = next_fragment;
+	m_put_session.completed_count = next_fragment;
+	for (int i = 0; i < std::max(1, window_size); ++i)
 	{
-		protocol::ReqPutFile request;
-		request.set_session_id(m_put_session.session_id);
-		request.set_fragment_index(fragment_index);
+		if (!put_next_fragment())
+		{
+			break;
+		}
+	}
+}
 
-		char content[protocol::MAX_FRAGMENT_CONTENT_LEN];
-		file.seek(fragment_index * protocol::MAX_FRAGMENT_CONTENT_LEN, lights::FileSeekWhence::BEGIN);
-		std::size_t content_len = file.read({content, protocol::MAX_FRAGMENT_CONTENT_LEN});
-		request.set_fragment_content(content, content_len);
-		Network::send_protocol(conn_id, request);
-		m_put_session.fragment_state[fragment_index] = true;
+
+bool SharingFileManager::put_next_fragment()
+{
+	int fragment_index = m_put_session.fragment_index;
+	if (fragment_index >= m_put_session.max_fragment)
+	{
+		return false;
 	}
+
+	put_fragment(fragment_index);
+	++m_put_session.fragment_index;
+	return true;
+}
+
+
+bool SharingFileManager::resend_fragment(int session_id, int fragment_index)
+{
+	// Error of other session, or error that is not associated with fragment like invalid session.
+	if (session_id == 0 || session_id != m_put_session.session_id ||
+		fragment_index < 0 || fragment_index >= m_put_session.fragment_index)
+	{
+		m_put_session.session_id = 0;
+		return false;
+	}
+
+	int& retry_count = m_put_session.fragment_retry_count[fragment_index];
+	if (retry_count >= PUT_FRAGMENT_MAX_RETRY)
+	{
+		m_put_session.session_id = 0;
+		return false;
+	}
+
+	++retry_count;
+	put_fragment(fragment_index);
+	return true;
+}
+
+
+void SharingFileManager::put_fragment(int fragment_index)
+{
+	lights::FileStream file(m_put_session.local_path, "r");
+	// Fragment is too large to put on stack.
+	std::vector<char> content(protocol::MAX_FRAGMENT_CONTENT_LEN);
+	protocol::ReqPutFile request;
+	request.set_session_id(m_put_session.session_id);
+	request.set_fragment_index(fragment_index);
+
+	file.seek(fragment_index * protocol::MAX_FRAGMENT_CONTENT_LEN, lights::FileSeekWhence::BEGIN);
+	std::size_t content_len = file.read({content.data(), content.size()});
+	request.set_fragment_content(content.data(), content_len);
+	Network::send_protocol(conn_id, request);
+	m_put_session.fragment_state[fragment_index] = true;
 }
 
 
@@ -189,7 +300,7 @@ void SharingFileManager::get_file(int group_id, const std::string& remote_path,
 	m_get_session.local_path = local_path;
 	m_get_session.group_id = group_id;
 	m_get_session.remote_path = remote_path;
-	m_get_session.start_time = lights::current_precise_time();
+	m_get_session.start_time = lights::current_monotonic_time();
 
 	protocol::ReqGetFileSession request;
 	request.set_group_id(group_id);
@@ -237,7 +348,7 @@ void SharingFileManager::create_path(int group_id, const std::string& path)
 	protocol::ReqCreatePath request;
 	request.set_group_id(group_id);
 	request.set_path(path);
-	Network::send_protocol(conn_id, request);
+	BatchManager::instance()->send_request(request);
 }
 
 
@@ -267,7 +378,7 @@ HeartbeatManager::HeartbeatManager() :
 	m_last_delay_time(),
 	m_total_delay_time(),
 	m_heartbeat_times(0),
-	m_timer_id(0)
+	m_timer_handle(INVALID_TIMER_HANDLE)
 {
 
 }
@@ -275,11 +386,12 @@ HeartbeatManager::HeartbeatManager() :
 
 void HeartbeatManager::start_heartbeat()
 {
-	m_timer_id = TimerManager::instance()->register_frequent_timer("start_heartbeat",
-																   lights::PreciseTime(HEARTBEAT_PER_SEC), []()
+	m_timer_handle = TimerManager::instance()->register_frequent_timer("start_heartbeat",
+																	   lights::PreciseTime(HEARTBEAT_PER_SEC), []()
 	{
 		protocol::ReqPing request;
-		lights::PreciseTime time = lights::current_precise_time();
+		// Server echoes send time back, so monotonic time is enough to measure round trip time.
+		lights::PreciseTime time = lights::current_monotonic_time();
 		request.set_second(static_cast<std::int32_t>(time.seconds));
 		std::int64_t microsecond = lights::nanosecond_to_microsecond(time.nanoseconds);
 		request.set_microsecond(static_cast<std::int32_t>(microsecond));
@@ -290,14 +402,14 @@ void HeartbeatManager::start_heartbeat()
 
 void HeartbeatManager::stop_heartbeat()
 {
-	TimerManager::instance()->remove_timer(m_timer_id);
+	TimerManager::instance()->remove_timer(m_timer_handle);
 }
 
 
 void HeartbeatManager::on_receive_response(int second, int microsecond)
 {
 	lights::PreciseTime send_time(second, lights::microsecond_to_nanosecond(microsecond));
-	lights::PreciseTime rtt = lights::current_precise_time() - send_time;
+	lights::PreciseTime rtt = lights::current_monotonic_time() - send_time;
 	m_last_delay_time = rtt / 2;
 	m_total_delay_time = m_total_delay_time + m_last_delay_time;
 	++m_heartbeat_times;
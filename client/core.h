@@ -13,6 +13,8 @@
 #include <lights/sequence.h>
 #include <lights/precise_time.h>
 #include <foundation/basics.h>
+#include <foundation/worker.h>
+#include <protocol/message_declare.h>
 
 
 namespace spaceless {
@@ -20,6 +22,52 @@ namespace client {
 
 extern int conn_id;
 
+/**
+ * Collects requests into one batch package, so bulk operation only has one package and one response.
+ * @note Only request of one phase transaction can be collected.
+ */
+class BatchManager
+{
+public:
+	SPACELESS_SINGLETON_INSTANCE(BatchManager);
+
+	/**
+	 * Starts to collect request that send by @c send_request.
+	 */
+	void start_batch();
+
+	/**
+	 * Stops collecting request and sends all collected requests.
+	 */
+	void send_batch();
+
+	/**
+	 * Checks is collecting request.
+	 */
+	bool is_batching() const;
+
+	/**
+	 * Sends request directly or collects it into batch. Batch is sent when it's full.
+	 */
+	void send_request(const protocol::Message& request);
+
+private:
+	struct Entry
+	{
+		int command;
+		std::string content;
+	};
+
+	/**
+	 * Sends all collected requests in one package.
+	 */
+	void flush();
+
+	bool m_is_batching = false;
+	std::vector<Entry> m_entry_list;
+};
+
+
 struct User
 {
 	User(int user_id, const std::string& username) :
@@ -78,8 +126,10 @@ struct FileSession
 		remote_path(),
 		max_fragment(0),
 		fragment_index(0),
+		completed_count(0),
 		start_time(),
-		fragment_state()
+		fragment_state(),
+		fragment_retry_count()
 	{}
 
 	int session_id;
@@ -87,9 +137,11 @@ struct FileSession
 	int group_id;
 	std::string remote_path;
 	int max_fragment;
-	int fragment_index;
+	int fragment_index; // Next fragment to send.
+	int completed_count;
 	lights::PreciseTime start_time;
 	std::map<int, bool> fragment_state;
+	std::map<int, int> fragment_retry_count;
 };
 
 
@@ -132,7 +184,23 @@ public:
 
 	void put_file(int group_id, const std::string& local_path, const std::string& remote_path);
 
-	void start_put_file(int next_fragment);
+	/**
+	 * Starts to put fragment from @c next_fragment and keeps @c window_size fragments in flight.
+	 */
+	void start_put_file(int next_fragment, int window_size);
+
+	/**
+	 * Puts next fragment of put file session.
+	 * @return Returns false if all fragments are put.
+	 */
+	bool put_next_fragment();
+
+	/**
+	 * Resends fragment that put failure. Session is aborted if error is not associated with fragment or fragment
+	 * exceeds retry times, then responses of in flight fragments are ignored and putting can resume by put file again.
+	 * @return Returns false if session is aborted.
+	 */
+	bool resend_fragment(int session_id, int fragment_index);
 
 	void get_file(int group_id, const std::string& remote_path, const std::string& local_path);
 
@@ -151,6 +219,11 @@ public:
 	FileSession& get_file_session();
 
 private:
+	/**
+	 * Reads fragment from local file and puts it.
+	 */
+	void put_fragment(int fragment_index);
+
 	FileSession m_put_session;
 	FileSession m_get_session;
 };
@@ -177,7 +250,7 @@ private:
 	lights::PreciseTime m_last_delay_time;
 	lights::PreciseTime m_total_delay_time;
 	int m_heartbeat_times;
-	int m_timer_id;
+	TimerHandle m_timer_handle;
 };
 
 
@@ -55,6 +55,9 @@ int main(int argc, const char* argv[])
 			}
 		}
 
+		// Request that is not processed in time budget is dropped by server. Zero means no deadline.
+		Network::set_request_time_budget(configuration.getInt("request_time_budget_ms", 0));
+
 		SPACELESS_REG_ONE_TRANS(protocol::RspPing, read_handler);
 		SPACELESS_REG_ONE_TRANS(protocol::RspRegisterUser, read_handler);
 		SPACELESS_REG_ONE_TRANS(protocol::RspLoginUser, read_handler);
@@ -74,6 +77,7 @@ int main(int argc, const char* argv[])
 		SPACELESS_REG_ONE_TRANS(protocol::RspGetFile, read_handler);
 		SPACELESS_REG_ONE_TRANS(protocol::RspCreatePath, read_handler);
 		SPACELESS_REG_ONE_TRANS(protocol::RspRemovePath, read_handler);
+		SPACELESS_REG_ONE_TRANS(protocol::RspBatch, read_handler);
 
 		NetworkConnection conn = NetworkManager::instance()->register_connection("127.0.0.1", 10240);
 		conn_id = conn.connection_id();
@@ -241,6 +245,15 @@ void cmd_ui_interface(ConnectionList& conn_list)
 			std::cin >> group_id >> path >> force_remove_all;
 			SharingFileManager::instance()->remove_path(group_id, path, force_remove_all);
 		}
+		else if (func_name == "start_batch")
+		{
+			BatchManager::instance()->start_batch();
+			std::cout << "Start batch. Request is sent after send_batch." << std::endl;
+		}
+		else if (func_name == "send_batch")
+		{
+			BatchManager::instance()->send_batch();
+		}
 		else if (func_name == "register_connection")
 		{
 			std::cout << "Please input host and port." << std::endl;
@@ -303,7 +316,8 @@ void read_handler(int conn_id, Package package)
 									error.error().code(),
 									command) << std::endl;
 
-		if (command != cmd("RspPing"))
+		// Failed fragment must be resent or session must be aborted, otherwise it occupies put window.
+		if (command != cmd("RspPing") && command != cmd("RspPutFile"))
 		{
 			return;
 		}
@@ -390,26 +404,46 @@ void read_handler(int conn_id, Package package)
 		package.parse_to_protocol(response);
 		FileSession& session = SharingFileManager::instance()->put_file_session();
 		session.session_id = response.session_id();
-		SharingFileManager::instance()->start_put_file(response.next_fragment());
+		SharingFileManager::instance()->start_put_file(response.next_fragment(), response.window_size());
 	}
 	else if (command == cmd("RspPutFile"))
 	{
 		protocol::RspPutFile response;
 		package.parse_to_protocol(response);
 		FileSession& session = SharingFileManager::instance()->put_file_session();
-		if (response.fragment_index() + 1 >= session.max_fragment)
+		if (session.session_id == 0)
+		{
+			// Session is aborted, ignores response of fragment that was in flight.
+			return;
+		}
+
+		if (response.has_error())
+		{
+			if (SharingFileManager::instance()->resend_fragment(response.session_id(), response.fragment_index()))
+			{
+				std::cout << lights::format("Resend file {} fragment {}.",
+											session.remote_path,
+											response.fragment_index()) << std::endl;
+			}
+			else
+			{
+				std::cout << lights::format("Put file {} abort, put it again to resume.", session.remote_path)
+						  << std::endl;
+			}
+			return;
+		}
+
+		// Fragment completes out of order, so finishes after all fragments completed.
+		++session.completed_count;
+		if (session.completed_count >= session.max_fragment)
 		{
-			lights::PreciseTime use_sec = lights::current_precise_time() - session.start_time;
+			lights::PreciseTime use_sec = lights::current_monotonic_time() - session.start_time;
 			std::cout << lights::format("Put file {} finish. use {}", session.remote_path, use_sec) << std::endl;
 		}
 		else
 		{
-//			session.fragment_state[]
-//			++session.fragment_index;
-//			SharingGroupManager::instance()->put_file(session.group_id,
-//													  session.local_path,
-//													  session.remote_path,
-//													  session.fragment_index);
+			// Keeps window full.
+			SharingFileManager::instance()->put_next_fragment();
 		}
 	}
 	else if (command == cmd("RspGetFileSession"))
@@ -437,10 +471,32 @@ void read_handler(int conn_id, Package package)
 		}
 		else
 		{
-			lights::PreciseTime use_sec = lights::current_precise_time() - session.start_time;
+			lights::PreciseTime use_sec = lights::current_monotonic_time() - session.start_time;
 			std::cout << lights::format("Get file {} finish. use {}", session.remote_path, use_sec) << std::endl;
 		}
 	}
+	else if (command == cmd("RspBatch"))
+	{
+		protocol::RspBatch response;
+		package.parse_to_protocol(response);
+		for (auto& entry : response.entry_list())
+		{
+			if (entry.command() == 0)
+			{
+				continue; // Request have no response.
+			}
+
+			// Handles each response as received package.
+			int content_len = static_cast<int>(entry.content().size());
+			Package entry_package = PackageManager::instance()->register_package(content_len);
+			entry_package.header().base.command = entry.command();
+			entry_package.header().base.content_length = content_len;
+			auto content = static_cast<char*>(entry_package.content_buffer().data());
+			std::copy(entry.content().begin(), entry.content().end(), content);
+			read_handler(conn_id, entry_package);
+			PackageManager::instance()->remove_package(entry_package.package_id());
+		}
+	}
 	else if (command == cmd("RspPing"))
 	{
 		protocol::RspPing response;
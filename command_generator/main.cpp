@@ -17,6 +17,25 @@
 
 using CommandTable = std::vector<std::pair<int, std::string>>;
 using MatchPatterns = std::vector<std::string>;
+using PriorityPatterns = std::vector<std::pair<std::string, std::string>>;
+
+
+/**
+ * Gets priority name of message. Message that contains pattern uses associated priority.
+ * Otherwise uses normal priority.
+ */
+std::string get_priority_name(const std::string& msg_name, const PriorityPatterns& priority_patterns)
+{
+	for (auto& pair : priority_patterns)
+	{
+		std::size_t pos = msg_name.rfind(pair.first);
+		if (pos != std::string::npos && pos + pair.first.length() == msg_name.length()) // Must end with pattern.
+		{
+			return pair.second;
+		}
+	}
+	return "normal";
+}
 
 CommandTable generate_commands(const std::string& proto_filename, const MatchPatterns& match_patterns, int next_cmd = 1)
 {
@@ -86,11 +105,21 @@ int main(int argc, const char* argv[])
 	int next_cmd = static_cast<int>(spaceless::BuildInCommand::MAX); // Avoid using build-in cmd.
 	CommandTable cmd_table = generate_commands(proto_filename, match_patterns, next_cmd);
 
+	// Heartbeat must not wait behind bulk fragment traffic.
+	PriorityPatterns priority_patterns = {
+		{ "Ping", "high" },
+		{ "PutFile", "low" },
+		{ "GetFile", "low" },
+	};
+
 	// Save cmd in txt.
 	std::ofstream txt_cmd_file(txt_cmd_filename);
 	for (auto& pair: cmd_table)
 	{
-		txt_cmd_file << lights::format("{} {}\n", lights::pad(pair.first, ' ', 5), pair.second);
+		txt_cmd_file << lights::format("{} {} {}\n",
+									   lights::pad(pair.first, ' ', 5),
+									   pair.second,
+									   get_priority_name(pair.second, priority_patterns));
 	}
 
 	// Save cmd in cpp file.
@@ -106,6 +135,15 @@ int main(int argc, const char* argv[])
 	}
 	cpp_cmd_file << "};\n";
 	cpp_cmd_file << "\n";
+	cpp_cmd_file << "const std::map<int, std::string> default_command_priority_map = {\n";
+	for (auto& pair: cmd_table)
+	{
+		cpp_cmd_file << lights::format("    {{}, \"{}\"},\n",
+									   lights::pad(pair.first, ' ', 5),
+									   get_priority_name(pair.second, priority_patterns));
+	}
+	cpp_cmd_file << "};\n";
+	cpp_cmd_file << "\n";
 	cpp_cmd_file << "} // namespace details\n";
 	cpp_cmd_file << "} // namespace protocol\n";
 	cpp_cmd_file << "} // namespace spaceless\n";
@@ -81,6 +81,12 @@ std::size_t aes_cipher_length(std::size_t plain_length)
 }
 
 
+std::size_t aes_gcm_cipher_length(std::size_t plain_length)
+{
+	return plain_length + AES_GCM_TAG_SIZE;
+}
+
+
 void aes_encrypt(lights::SequenceView plain, lights::Sequence cipher, const AesKey& key)
 {
 	std::size_t over = plain.length() % AES_BLOCK_SIZE;
@@ -12,6 +12,7 @@
 #include <iosfwd>
 
 #include <cryptopp/aes.h>
+#include <cryptopp/gcm.h>
 #include <lights/sequence.h>
 
 #include "basic.h"
@@ -200,11 +201,143 @@ private:
 };
 
 
+constexpr std::size_t AES_GCM_IV_SIZE = 12;
+constexpr std::size_t AES_GCM_TAG_SIZE = 16;
+
+using AesGcmIv = std::array<byte, AES_GCM_IV_SIZE>;
+
+
+/**
+ * Encrypt and authenticate message with AES in GCM mode. Key schedule is expanded once when setting key and each
+ * message only resets IV. Message can be encrypted by multiple calls, that is the same as encrypted by one call.
+ * Calling sequence of each message is @c start, @c authenticate, @c encrypt and @c finish.
+ */
+class AesGcmEncryptor
+{
+public:
+	/**
+	 * Sets encryption key.
+	 */
+	void set_key(const AesKey& key)
+	{
+		auto& key_value = key.get_value();
+		m_encryption.SetKey(reinterpret_cast<const byte*>(key_value.data()), key_value.size());
+	}
+
+	/**
+	 * Starts a message. IV must not be reused with the same key.
+	 */
+	void start(const AesGcmIv& iv)
+	{
+		m_encryption.Resynchronize(iv.data(), static_cast<int>(iv.size()));
+	}
+
+	/**
+	 * Authenticates additional data that is not encrypted.
+	 * @note Must call before @c encrypt.
+	 */
+	void authenticate(const char* data, std::size_t length)
+	{
+		m_encryption.Update(reinterpret_cast<const byte*>(data), length);
+	}
+
+	/**
+	 * Encrypt data in place. Data length is not necessary to be multiple of @c AES_BLOCK_SIZE.
+	 */
+	void encrypt(char* data, std::size_t length)
+	{
+		auto bytes = reinterpret_cast<byte*>(data);
+		m_encryption.ProcessData(bytes, bytes, length);
+	}
+
+	/**
+	 * Finishes message and writes authentication tag that length is @c AES_GCM_TAG_SIZE.
+	 */
+	void finish(char* tag)
+	{
+		m_encryption.TruncatedFinal(reinterpret_cast<byte*>(tag), AES_GCM_TAG_SIZE);
+	}
+
+private:
+	CryptoPP::GCM<CryptoPP::AES>::Encryption m_encryption;
+};
+
+
+/**
+ * Decrypt and verify message with AES in GCM mode.
+ * Calling sequence of each message is @c start, @c authenticate, @c decrypt and @c finish.
+ * @note Decrypted data cannot be used until @c finish verifies it.
+ */
+class AesGcmDecryptor
+{
+public:
+	/**
+	 * Sets decryption key.
+	 */
+	void set_key(const AesKey& key)
+	{
+		auto& key_value = key.get_value();
+		m_decryption.SetKey(reinterpret_cast<const byte*>(key_value.data()), key_value.size());
+	}
+
+	/**
+	 * Starts a message with IV that message is encrypted.
+	 */
+	void start(const AesGcmIv& iv)
+	{
+		m_decryption.Resynchronize(iv.data(), static_cast<int>(iv.size()));
+	}
+
+	/**
+	 * Authenticates additional data that is not encrypted.
+	 * @note Must call before @c decrypt.
+	 */
+	void authenticate(const char* data, std::size_t length)
+	{
+		m_decryption.Update(reinterpret_cast<const byte*>(data), length);
+	}
+
+	/**
+	 * Decrypt data in place.
+	 */
+	void decrypt(char* data, std::size_t length)
+	{
+		auto bytes = reinterpret_cast<byte*>(data);
+		m_decryption.ProcessData(bytes, bytes, length);
+	}
+
+	/**
+	 * Decrypt data from @c in to @c out.
+	 */
+	void decrypt(const char* in, char* out, std::size_t length)
+	{
+		m_decryption.ProcessData(reinterpret_cast<byte*>(out), reinterpret_cast<const byte*>(in), length);
+	}
+
+	/**
+	 * Finishes message and verifies authentication tag that length is @c AES_GCM_TAG_SIZE.
+	 * @return Returns false if message or additional data is modified.
+	 */
+	bool finish(const char* tag)
+	{
+		return m_decryption.TruncatedVerify(reinterpret_cast<const byte*>(tag), AES_GCM_TAG_SIZE);
+	}
+
+private:
+	CryptoPP::GCM<CryptoPP::AES>::Decryption m_decryption;
+};
+
+
 /**
  * Returns AES cipher length.
  */
 std::size_t aes_cipher_length(std::size_t plain_length);
 
+/**
+ * Returns AES GCM cipher length that includes authentication tag.
+ */
+std::size_t aes_gcm_cipher_length(std::size_t plain_length);
+
 /**
  * Uses AES method to encrypt plain to cipher.
  */
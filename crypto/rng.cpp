@@ -13,7 +13,8 @@ namespace crypto {
 
 RandomNumberGenerator& get_default_rng()
 {
-	static CryptoPP::AutoSeededRandomPool rng;
+	// Random pool is not thread safe, so each thread has its own one.
+	static thread_local CryptoPP::AutoSeededRandomPool rng;
 	return rng;
 }
 
@@ -15,6 +15,10 @@ namespace crypto {
 
 using RandomNumberGenerator = CryptoPP::RandomNumberGenerator;
 
+/**
+ * Returns random number generator of current thread.
+ * @note Returned generator cannot be shared with other thread.
+ */
 RandomNumberGenerator& get_default_rng();
 
 } // namespace crypto
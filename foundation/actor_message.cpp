@@ -6,36 +6,311 @@
 
 #include "actor_message.h"
 
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <algorithm>
+
+#include "exception.h"
+
 
 namespace spaceless {
 
-void ActorMessageQueue::push(QueueType queue_type, const ActorMessage& msg)
+// Recycled blocks of delegate function. Delegation is rare, so mutex is enough.
+static std::vector<void*> delegate_block_list;
+static std::mutex delegate_block_mutex;
+
+
+void* DelegateFunction::allocate_block()
+{
+	{
+		std::lock_guard<std::mutex> lock(delegate_block_mutex);
+		if (!delegate_block_list.empty())
+		{
+			void* block = delegate_block_list.back();
+			delegate_block_list.pop_back();
+			return block;
+		}
+	}
+	return ::operator new(sizeof(DelegateFunction));
+}
+
+
+void DelegateFunction::deallocate_block(void* block)
+{
+	{
+		std::lock_guard<std::mutex> lock(delegate_block_mutex);
+		if (delegate_block_list.size() < DELEGATE_POOL_MAX_BLOCK)
+		{
+			delegate_block_list.push_back(block);
+			return;
+		}
+	}
+	::operator delete(block);
+}
+
+
+void DelegateFunction::destroy(DelegateFunction* function)
+{
+	function->m_destroyer(function->m_callable);
+	function->~DelegateFunction();
+	deallocate_block(function);
+}
+
+
+
+ActorMessageQueue::ActorMessageQueue() :
+	m_is_single_producer{false, false},
+	m_lane_weight{ACTOR_HIGH_PRIORITY_WEIGHT, ACTOR_NORMAL_PRIORITY_WEIGHT, ACTOR_LOW_PRIORITY_WEIGHT}
+{
+	for (int queue_type = 0; queue_type < QueueType::MAX; ++queue_type)
+	{
+		m_channel_list[queue_type].push_back(create_channel(static_cast<QueueType>(queue_type)));
+	}
+}
+
+
+void ActorMessageQueue::set_channel_count(QueueType queue_type, std::size_t count)
+{
+	auto& channel_list = m_channel_list[queue_type];
+	channel_list.resize(std::min(channel_list.size(), count));
+	while (channel_list.size() < count)
+	{
+		channel_list.push_back(create_channel(queue_type));
+	}
+}
+
+
+std::size_t ActorMessageQueue::channel_count(QueueType queue_type) const
+{
+	return m_channel_list[queue_type].size();
+}
+
+
+void ActorMessageQueue::set_single_producer(QueueType queue_type, bool is_single_producer)
+{
+	m_is_single_producer[queue_type] = is_single_producer;
+	for (auto& channel : m_channel_list[queue_type])
+	{
+		for (auto& lane : channel->lane_list)
+		{
+			lane->set_single_producer(is_single_producer);
+		}
+	}
+}
+
+
+void ActorMessageQueue::set_priority_weight(CommandPriority priority, int weight)
+{
+	// Lane of zero weight never gets credit, so its message is never popped.
+	if (weight <= 0)
+	{
+		SPACELESS_THROW(ERR_ACTOR_MESSAGE_INVALID_PRIORITY_WEIGHT);
+	}
+
+	m_lane_weight[static_cast<int>(priority)] = weight;
+	for (auto& channel_list : m_channel_list)
+	{
+		for (auto& channel : channel_list)
+		{
+			channel->lane_credit[static_cast<int>(priority)] = weight;
+		}
+	}
+}
+
+
+void ActorMessageQueue::push(QueueType queue_type,
+							 const ActorMessage& msg,
+							 CommandPriority priority,
+							 std::size_t channel)
+{
+	Channel& target = *m_channel_list[queue_type][channel];
+	RingQueue<ActorMessage>& lane = *target.lane_list[static_cast<int>(priority)];
+	while (!lane.push(msg))
+	{
+		// Consumer is waked up by message that is already in lane, so only need to wait it pops.
+		std::this_thread::yield();
+	}
+	wake_up_consumer(target);
+}
+
+
+void ActorMessageQueue::push(QueueType queue_type,
+							 const ActorMessage* msg_list,
+							 std::size_t count,
+							 CommandPriority priority,
+							 std::size_t channel)
 {
-	std::lock_guard<std::mutex> lock(m_mutex[queue_type]);
-	m_queue[queue_type].push(msg);
+	Channel& target = *m_channel_list[queue_type][channel];
+	RingQueue<ActorMessage>& lane = *target.lane_list[static_cast<int>(priority)];
+	std::size_t push_count = 0;
+	while (push_count < count)
+	{
+		std::size_t len = lane.push(msg_list + push_count, count - push_count);
+		push_count += len;
+		if (len == 0)
+		{
+			wake_up_consumer(target);
+			std::this_thread::yield();
+		}
+	}
+	wake_up_consumer(target);
 }
 
 
-ActorMessage ActorMessageQueue::pop(QueueType queue_type)
+bool ActorMessageQueue::try_push(QueueType queue_type,
+								 const ActorMessage& msg,
+								 CommandPriority priority,
+								 std::size_t channel)
 {
-	std::lock_guard<std::mutex> lock(m_mutex[queue_type]);
-	ActorMessage msg = m_queue[queue_type].front();
-	m_queue[queue_type].pop();
-	return msg;
+	Channel& target = *m_channel_list[queue_type][channel];
+	RingQueue<ActorMessage>& lane = *target.lane_list[static_cast<int>(priority)];
+	if (!lane.push(msg))
+	{
+		return false;
+	}
+	wake_up_consumer(target);
+	return true;
+}
+
+
+bool ActorMessageQueue::pop(QueueType queue_type, ActorMessage& msg, std::size_t channel)
+{
+	Channel& target = *m_channel_list[queue_type][channel];
+	int* credit_list = target.lane_credit;
+	for (int round = 0; round < 2; ++round)
+	{
+		// Pops from the highest priority lane that still have credit in current round.
+		for (int lane = 0; lane < LANE_NUM; ++lane)
+		{
+			if (credit_list[lane] > 0 && target.lane_list[lane]->pop(msg))
+			{
+				--credit_list[lane];
+				return true;
+			}
+		}
+
+		// All lanes that have message already use up credit. Starts a new round.
+		for (int lane = 0; lane < LANE_NUM; ++lane)
+		{
+			credit_list[lane] = m_lane_weight[lane];
+		}
+	}
+	return false;
+}
+
+
+std::size_t ActorMessageQueue::pop(QueueType queue_type,
+								   ActorMessage* msg_list,
+								   std::size_t max_count,
+								   std::size_t channel)
+{
+	std::size_t count = 0;
+	while (count < max_count && pop(queue_type, msg_list[count], channel))
+	{
+		++count;
+	}
+	return count;
 }
 
 
 bool ActorMessageQueue::empty(ActorMessageQueue::QueueType queue_type)
 {
-	std::lock_guard<std::mutex> lock(m_mutex[queue_type]);
-	return m_queue[queue_type].empty();
+	for (auto& channel : m_channel_list[queue_type])
+	{
+		if (!empty(*channel))
+		{
+			return false;
+		}
+	}
+	return true;
 }
 
 
 std::size_t ActorMessageQueue::size(ActorMessageQueue::QueueType queue_type)
 {
-	std::lock_guard<std::mutex> lock(m_mutex[queue_type]);
-	return m_queue[queue_type].size();
+	std::size_t size = 0;
+	for (auto& channel : m_channel_list[queue_type])
+	{
+		for (auto& lane : channel->lane_list)
+		{
+			size += lane->size();
+		}
+	}
+	return size;
+}
+
+
+void ActorMessageQueue::wait(QueueType queue_type, lights::PreciseTime timeout, std::size_t channel)
+{
+	Channel& target = *m_channel_list[queue_type][channel];
+
+	// Publishes waiting state before check queue. Pairs with fence in wake_up_consumer, so at least
+	// one side can see the other and wake up never lose.
+	target.is_waiting.store(true, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	{
+		std::unique_lock<std::mutex> lock(target.wait_mutex);
+		auto duration = std::chrono::seconds(timeout.seconds) + std::chrono::nanoseconds(timeout.nanoseconds);
+		target.wait_condition.wait_for(lock, duration, [this, &target]
+		{
+			return target.is_notified || !empty(target);
+		});
+		target.is_notified = false;
+	}
+
+	target.is_waiting.store(false, std::memory_order_relaxed);
+}
+
+
+void ActorMessageQueue::notify(QueueType queue_type, std::size_t channel)
+{
+	Channel& target = *m_channel_list[queue_type][channel];
+	std::lock_guard<std::mutex> lock(target.wait_mutex);
+	target.is_notified = true;
+	target.wait_condition.notify_one();
+}
+
+
+ActorMessageQueue::ChannelPtr ActorMessageQueue::create_channel(QueueType queue_type)
+{
+	ChannelPtr channel(new Channel());
+	for (int lane = 0; lane < LANE_NUM; ++lane)
+	{
+		channel->lane_list[lane].reset(new RingQueue<ActorMessage>(ACTOR_QUEUE_CAPACITY,
+																	m_is_single_producer[queue_type]));
+		channel->lane_credit[lane] = m_lane_weight[lane];
+	}
+	channel->is_waiting = false;
+	channel->is_notified = false;
+	return channel;
+}
+
+
+bool ActorMessageQueue::empty(Channel& channel)
+{
+	for (auto& lane : channel.lane_list)
+	{
+		if (!lane->empty())
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+void ActorMessageQueue::wake_up_consumer(Channel& channel)
+{
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (channel.is_waiting.load(std::memory_order_relaxed))
+	{
+		// Locks to avoid notify between consumer check queue and start to wait.
+		std::lock_guard<std::mutex> lock(channel.wait_mutex);
+		channel.wait_condition.notify_one();
+	}
 }
 
 } // namespace spaceless
@@ -6,19 +6,87 @@
 
 #pragma once
 
-#include <functional>
-#include <queue>
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <memory>
 #include <mutex>
+#include <condition_variable>
+#include <new>
+#include <utility>
+#include <vector>
+#include <type_traits>
 
 #include <lights/sequence.h>
+#include <lights/precise_time.h>
 
 #include "basics.h"
+#include "ring_queue.h"
 
 
 namespace spaceless {
 
 /**
- * ActorMessage uses to operation difference actor(thread).
+ * Type-erased function that is stored in fixed-size block. Block is recycled by pool, so function
+ * that capture is not larger than @c INLINE_CAPACITY never allocate memory after warming up.
+ */
+class DelegateFunction
+{
+public:
+	static const std::size_t INLINE_CAPACITY = 96;
+
+	/**
+	 * Creates delegate function in pooled block.
+	 * @note Must call @c destroy after using.
+	 */
+	template <typename Function>
+	static DelegateFunction* create(Function&& function);
+
+	/**
+	 * Destroys delegate function and recycle its block.
+	 */
+	static void destroy(DelegateFunction* function);
+
+	/**
+	 * Disable copy constructor.
+	 */
+	DelegateFunction(const DelegateFunction&) = delete;
+
+	/**
+	 * Calls underlying function.
+	 */
+	void operator()()
+	{
+		m_invoker(m_callable);
+	}
+
+private:
+	using Invoker = void (*)(void*);
+	using Destroyer = void (*)(void*);
+
+	DelegateFunction() = default;
+
+	/**
+	 * Gets block from pool or allocates new block.
+	 */
+	static void* allocate_block();
+
+	/**
+	 * Returns block to pool.
+	 */
+	static void deallocate_block(void* block);
+
+	Invoker m_invoker;
+	Destroyer m_destroyer;
+	// Points to inline storage or heap when function is too large.
+	void* m_callable;
+	alignas(std::max_align_t) char m_storage[INLINE_CAPACITY];
+};
+
+
+/**
+ * ActorMessage uses to operation difference actor(thread). It's compact tagged message that can be copy as
+ * plain data. Delegate message owns its function until it's processed or discarded.
  */
 struct ActorMessage
 {
@@ -30,37 +98,39 @@ struct ActorMessage
 
 	struct NetworkMsg
 	{
-		NetworkMsg() :
-			conn_id(0),
-			service_id(0),
-			package_id(0)
-		{}
-
 		int conn_id;
 		int service_id;
 		int package_id;
+		std::int64_t push_time_us; // Monotonic time of pushing to input queue. It's zero if not record.
 	};
 
 	struct DelegateMsg
 	{
-		DelegateMsg() :
-			function(),
-			caller(lights::invalid_string_view())
-		{}
-
-		std::function<void()> function;
+		DelegateFunction* function;
 		lights::StringView caller;
 	};
 
+	ActorMessage() :
+		type(NETWORK_TYPE),
+		network_msg{0, 0, 0, 0}
+	{}
+
 	Type type;
-	NetworkMsg network_msg;
-	DelegateMsg delegate_msg;
+	union
+	{
+		NetworkMsg network_msg;
+		DelegateMsg delegate_msg;
+	};
 };
 
 
 /**
  * Actor message queue include input queue and output queue. It's use to separate network thread and worker thread.
- * So all operation of this class is thread safe.
+ * So all operation of this class is thread safe. Each queue is bounded lock-free ring that only have one consumer.
+ * Each queue have a lane for each priority and pop message by weight of lane. When all lanes have message,
+ * each lane is popped according to its weight in every round, so low priority lane never starve.
+ * Queue can be divided into several channels, and each channel is consumed by one thread. Input queue has
+ * a channel for each worker.
  */
 class ActorMessageQueue
 {
@@ -75,29 +145,164 @@ public:
 	};
 
 	/**
-	 * Pushes message to indicate queue.
+	 * Creates actor message queue.
+	 */
+	ActorMessageQueue();
+
+	/**
+	 * Sets number of channel of indicate queue. Each channel has its own consumer.
+	 * @note Must set before any message is pushed.
+	 */
+	void set_channel_count(QueueType queue_type, std::size_t count);
+
+	/**
+	 * Returns number of channel of indicate queue.
+	 */
+	std::size_t channel_count(QueueType queue_type) const;
+
+	/**
+	 * Sets indicate queue only have one producer thread to avoid compare and swap when push.
+	 * @note Must set before any message is pushed. Cannot set if compute pool pushes continuation to queue.
 	 */
-	void push(QueueType queue_type, const ActorMessage& msg);
+	void set_single_producer(QueueType queue_type, bool is_single_producer);
 
 	/**
-	 * Pops message of indicate queue.
+	 * Sets number of message that can be popped from lane of priority in each round.
+	 * @note Must set before start scheduler.
+	 * @throw Throws exception if weight is not greater than zero.
 	 */
-	ActorMessage pop(QueueType queue_type);
+	void set_priority_weight(CommandPriority priority, int weight);
 
 	/**
-	 * Checks indicate queue is empty.
+	 * Pushes message to indicate channel of queue. Waits consumer to pop message if lane is full.
+	 * @note Network thread cannot wait on input queue, or network and worker may wait each other.
+	 *       It uses @c try_push and stops receiving instead.
+	 */
+	void push(QueueType queue_type,
+			  const ActorMessage& msg,
+			  CommandPriority priority = CommandPriority::NORMAL,
+			  std::size_t channel = 0);
+
+	/**
+	 * Pushes a list of message to indicate channel of queue. Waits consumer to pop message if lane is full.
+	 */
+	void push(QueueType queue_type,
+			  const ActorMessage* msg_list,
+			  std::size_t count,
+			  CommandPriority priority = CommandPriority::NORMAL,
+			  std::size_t channel = 0);
+
+	/**
+	 * Pushes message to indicate channel of queue without waiting.
+	 * @return Returns false if lane is full and message is still owned by caller.
+	 */
+	bool try_push(QueueType queue_type,
+				  const ActorMessage& msg,
+				  CommandPriority priority = CommandPriority::NORMAL,
+				  std::size_t channel = 0);
+
+	/**
+	 * Pops message of indicate channel by weight of priority lane.
+	 * @return Returns false if channel is empty.
+	 */
+	bool pop(QueueType queue_type, ActorMessage& msg, std::size_t channel = 0);
+
+	/**
+	 * Pops a list of message of indicate channel.
+	 * @return Returns number of message that is popped.
+	 */
+	std::size_t pop(QueueType queue_type, ActorMessage* msg_list, std::size_t max_count, std::size_t channel = 0);
+
+	/**
+	 * Checks all channels of indicate queue are empty.
 	 */
 	bool empty(QueueType queue_type);
 
 	/**
-	 * Gets size of indicate queue.
+	 * Gets size of all channels of indicate queue.
 	 */
 	std::size_t size(QueueType queue_type);
 
+	/**
+	 * Blocks consumer until indicate channel have message, @c notify is called or timeout.
+	 * @param timeout  Max time to wait.
+	 * @note Only consumer of channel can wait.
+	 */
+	void wait(QueueType queue_type, lights::PreciseTime timeout, std::size_t channel = 0);
+
+	/**
+	 * Wakes up consumer that waiting on indicate channel even if channel is empty.
+	 */
+	void notify(QueueType queue_type, std::size_t channel = 0);
+
 private:
-	std::queue<ActorMessage> m_queue[QueueType::MAX];
-	std::mutex m_mutex[QueueType::MAX];
+	static const int LANE_NUM = static_cast<int>(CommandPriority::MAX);
+
+	struct Channel
+	{
+		std::unique_ptr<RingQueue<ActorMessage>> lane_list[LANE_NUM];
+		// Remaining number of message that can be popped from lane in current round. Only use by consumer.
+		int lane_credit[LANE_NUM];
+		// Producer only touches mutex when consumer is waiting, so push keeps lock-free in busy time.
+		std::atomic<bool> is_waiting;
+		bool is_notified;
+		std::mutex wait_mutex;
+		std::condition_variable wait_condition;
+	};
+
+	using ChannelPtr = std::unique_ptr<Channel>;
+
+	/**
+	 * Creates channel with empty lanes.
+	 */
+	ChannelPtr create_channel(QueueType queue_type);
+
+	/**
+	 * Checks all lanes of channel are empty.
+	 */
+	bool empty(Channel& channel);
+
+	/**
+	 * Wakes up consumer of channel after push if it's waiting.
+	 */
+	void wake_up_consumer(Channel& channel);
+
+	std::vector<ChannelPtr> m_channel_list[QueueType::MAX];
+	bool m_is_single_producer[QueueType::MAX];
+	int m_lane_weight[LANE_NUM];
 };
 
 
+// ================================= Inline implement. =================================
+
+template <typename Function>
+DelegateFunction* DelegateFunction::create(Function&& function)
+{
+	using Callable = std::decay_t<Function>;
+
+	auto delegate_function = new (allocate_block()) DelegateFunction();
+	if constexpr (sizeof(Callable) <= INLINE_CAPACITY && alignof(Callable) <= alignof(std::max_align_t))
+	{
+		delegate_function->m_callable = new (delegate_function->m_storage) Callable(std::forward<Function>(function));
+		delegate_function->m_destroyer = [](void* callable)
+		{
+			static_cast<Callable*>(callable)->~Callable();
+		};
+	}
+	else
+	{
+		delegate_function->m_callable = new Callable(std::forward<Function>(function));
+		delegate_function->m_destroyer = [](void* callable)
+		{
+			delete static_cast<Callable*>(callable);
+		};
+	}
+
+	delegate_function->m_invoker = [](void* callable)
+	{
+		(*static_cast<Callable*>(callable))();
+	};
+	return delegate_function;
+}
+
 } // namespace spaceless
@@ -9,5 +9,6 @@
 namespace spaceless {
 
 const char* WORKER_THREAD_NAME = "Worker";
+const char* COMPUTE_THREAD_NAME = "Compute";
 
 } // namespace spaceless
\ No newline at end of file
@@ -22,16 +22,38 @@ static class_name* instance() \
 namespace spaceless {
 
 const int INVALID_ID = 0;
-const int PACKAGE_VERSION = 2;
+const int PACKAGE_VERSION = 4;
 const int REACTOR_TIMEOUT_MS = 5;
 const int REACTOR_MAX_MSG_PER_TIMES = 10;
-const int WORKER_IDLE_SLEEP_MS = 2;
-const int WORKER_LONG_IDLE_TIMES = 5;
-const int WORKER_LONG_IDLE_SLEEP_MS = 10;
+const std::size_t ACTOR_QUEUE_CAPACITY = 16384; // Capacity of each priority lane.
+const int ACTOR_HIGH_PRIORITY_WEIGHT = 8;
+const int ACTOR_NORMAL_PRIORITY_WEIGHT = 4;
+const int ACTOR_LOW_PRIORITY_WEIGHT = 1;
+const std::size_t DELEGATE_POOL_MAX_BLOCK = 1024;
+const std::size_t COROUTINE_FRAME_MAX_POOL_SIZE = 2048; // Larger frame is not pooled.
+const std::size_t COROUTINE_FRAME_POOL_MAX_BLOCK = 256; // Max number of pooled frame of each size.
+const std::size_t TRANSACTION_MAX_POOL_SIZE = 1024; // Larger transaction object is not pooled.
+const std::size_t TRANSACTION_POOL_MAX_BLOCK = 1024; // Max number of pooled transaction object of each size.
+const int WORKER_MAX_NUM = 64;
+const int WORKER_MAX_WAIT_MS = 500; // Max time of worker blocking when have no message and timer.
+const std::size_t WORKER_BATCH_MAX_COUNT = 64; // Max number of message that processed before servicing timer.
+const int WORKER_BATCH_MAX_TIME_US = 1000; // Max time of processing message before servicing timer.
+const std::size_t WORKER_BATCH_TIME_CHECK_PERIOD = 8; // Number of message between checking time of batch.
+const int WORKER_LOOP_STATS_PER_SEC = 60;
+const int TIMER_TICK_MS = 1; // Precision of timer.
+const int BATCH_MAX_ENTRY_NUM = 256; // Max number of entry in one batch package.
+const int ADAPTIVE_TIMEOUT_MIN_MS = 20; // Keeps adaptive timeout far larger than precision of timer.
+const int ADAPTIVE_TIMEOUT_MAX_MS = 10000;
+const int ADAPTIVE_TIMEOUT_MULTIPLIER = 4; // Adaptive timeout is multiple of p99 of response latency.
+const std::size_t ADAPTIVE_TIMEOUT_WINDOW = 256; // Number of response that derives adaptive timeout once.
+const int COMPUTE_DEFAULT_THREAD_NUM = 2;
+const int COMPUTE_MAX_THREAD_NUM = 64;
+const std::size_t RSA_KEY_POOL_DEFAULT_SIZE = 8; // Number of pre-generated RSA key pair for secure handshake.
 const int SCHEDULER_WAITING_STOP_PERIOD_MS = 100;
 const int MONITOR_STATE_PER_SEC = 5;
 
 extern const char* WORKER_THREAD_NAME;
+extern const char* COMPUTE_THREAD_NAME;
 
 enum
 {
@@ -44,12 +66,18 @@ enum
 	ERR_NETWORK_SERVICE_NOT_EXIST = 111,
 	ERR_PROTOCOL_COMMAND_NOT_EXIST = 115,
 	ERR_PROTOCOL_NAME_NOT_EXIST = 116,
+	ERR_PROTOCOL_PRIORITY_NOT_EXIST = 117,
 	ERR_TRANSACTION_ALREADY_EXIST = 120,
 	ERR_MULTIPLY_PHASE_TRANSACTION_ALREADY_EXIST = 121,
 	ERR_BOUND_TRANSACTION_ALREADY_EXIST = 122,
 	ERR_TRANSACTION_TIMEOUT = 123,
+	ERR_TRANSACTION_DEADLINE_EXCEEDED = 124,
 	ERR_MONITOR_MANAGER_ALREADY_EXIST = 125,
+	ERR_BATCH_TOO_MANY_ENTRY = 130,
+	ERR_BATCH_INVALID_ENTRY = 131,
 	ERR_EVENT_ALREADY_EXIST = 140,
+	ERR_WORKER_NOT_CURRENT_THREAD = 145,
+	ERR_ACTOR_MESSAGE_INVALID_PRIORITY_WEIGHT = 150,
 	ERR_CRYPTO_CIPHER_SPACE_NOT_ENOUGH = 200,
 	ERR_CRYPTO_PLAIN_SPACE_NOT_ENOUGH = 201,
 	ERR_CRYPTO_INCOMPLETE_DATA = 202,
@@ -65,6 +93,18 @@ enum class BuildInCommand
 	MAX = 1000,
 };
 
+/**
+ * Priority of command. Message of high priority will be processed first, but low priority still have
+ * some chance to be processed.
+ */
+enum class CommandPriority
+{
+	HIGH = 0,
+	NORMAL = 1,
+	LOW = 2,
+	MAX = 3,
+};
+
 enum class SecuritySetting: std::uint8_t
 {
 	CLOSE_SECURITY = 1,
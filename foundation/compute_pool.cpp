@@ -0,0 +1,214 @@
+/**
+ * compute_pool.cpp
+ * @author wherewindblow
+ * @date   Mar 14, 2019
+ */
+
+#include "compute_pool.h"
+
+#include <algorithm>
+#include <string>
+#include <sys/prctl.h>
+
+#include "exception.h"
+#include "log.h"
+#include "thread_placement.h"
+
+
+namespace spaceless {
+
+static Logger& logger = get_logger("compute");
+static thread_local lights::TextWriter error_msg;
+// Index of compute thread that run in current thread. It's -1 if current thread is not compute thread.
+static thread_local int current_thread_index = -1;
+
+
+ComputePool::ComputePool() :
+	m_thread_count(COMPUTE_DEFAULT_THREAD_NUM),
+	m_deque_list(),
+	m_thread_list(),
+	m_task_count(0),
+	m_next_deque(0),
+	m_stop_flag(false)
+{
+	for (int i = 0; i < m_thread_count; ++i)
+	{
+		m_deque_list.emplace_back(new TaskDeque());
+	}
+}
+
+
+void ComputePool::set_thread_count(int count)
+{
+	count = std::max(1, std::min(count, COMPUTE_MAX_THREAD_NUM));
+	while (static_cast<int>(m_deque_list.size()) < count)
+	{
+		m_deque_list.emplace_back(new TaskDeque());
+	}
+	m_thread_count = count;
+}
+
+
+int ComputePool::thread_count() const
+{
+	return m_thread_count;
+}
+
+
+void ComputePool::start()
+{
+	if (!m_thread_list.empty())
+	{
+		LIGHTS_ASSERT(false && "Compute pool already started");
+		return;
+	}
+
+	LIGHTS_INFO(logger, "Starting compute pool. thread_count={}.", m_thread_count);
+	m_stop_flag = false;
+	for (int i = 0; i < m_thread_count; ++i)
+	{
+		m_thread_list.emplace_back([this, i]()
+		{
+			run(i);
+		});
+	}
+}
+
+
+void ComputePool::stop()
+{
+	if (m_thread_list.empty())
+	{
+		return;
+	}
+
+	LIGHTS_INFO(logger, "Stopping compute pool.");
+	{
+		std::lock_guard<std::mutex> lock(m_wait_mutex);
+		m_stop_flag = true;
+	}
+	m_wait_condition.notify_all();
+
+	for (auto& thread : m_thread_list)
+	{
+		thread.join();
+	}
+	m_thread_list.clear();
+
+	for (auto& task_deque : m_deque_list)
+	{
+		for (Task& task : task_deque->task_list)
+		{
+			LIGHTS_ERROR(logger, "Discard compute task because pool is stopped. caller={}.", task.caller);
+			DelegateFunction::destroy(task.function);
+		}
+		task_deque->task_list.clear();
+	}
+	m_task_count = 0;
+	LIGHTS_INFO(logger, "Stopped compute pool.");
+}
+
+
+void ComputePool::push(lights::StringView caller, DelegateFunction* function)
+{
+	// Task that is pushed by compute thread is run by itself first to keep data in cache.
+	std::size_t index = current_thread_index >= 0 ?
+						static_cast<std::size_t>(current_thread_index) :
+						m_next_deque.fetch_add(1, std::memory_order_relaxed) % static_cast<std::size_t>(m_thread_count);
+
+	TaskDeque& task_deque = *m_deque_list[index];
+	{
+		std::lock_guard<std::mutex> lock(task_deque.mutex);
+		task_deque.task_list.push_back(Task{function, caller});
+	}
+	m_task_count.fetch_add(1, std::memory_order_release);
+
+	// Locks to avoid notify between thread check task count and start to wait.
+	{
+		std::lock_guard<std::mutex> lock(m_wait_mutex);
+	}
+	m_wait_condition.notify_one();
+}
+
+
+bool ComputePool::is_compute_thread() const
+{
+	return current_thread_index >= 0;
+}
+
+
+std::size_t ComputePool::size() const
+{
+	return m_task_count.load(std::memory_order_acquire);
+}
+
+
+void ComputePool::run(int index)
+{
+	current_thread_index = index;
+	std::string thread_name = COMPUTE_THREAD_NAME + std::to_string(index);
+	prctl(PR_SET_NAME, thread_name.c_str());
+	ThreadPlacement::instance()->apply(ThreadType::COMPUTE, index, thread_name);
+	LIGHTS_INFO(logger, "Running compute thread {}.", index);
+
+	while (!m_stop_flag)
+	{
+		Task task = {nullptr, ""};
+		if (!pop_task(index, task))
+		{
+			std::unique_lock<std::mutex> lock(m_wait_mutex);
+			m_wait_condition.wait(lock, [this]
+			{
+				return m_stop_flag || m_task_count.load(std::memory_order_acquire) != 0;
+			});
+			continue;
+		}
+
+		if (!safe_call([&task]() { (*task.function)(); }, error_msg))
+		{
+			LIGHTS_ERROR(logger, "Compute {}: {}.", task.caller, error_msg.c_str());
+		}
+		DelegateFunction::destroy(task.function);
+	}
+
+	LIGHTS_INFO(logger, "Stopped compute thread {}.", index);
+}
+
+
+bool ComputePool::pop_task(int index, Task& task)
+{
+	if (m_task_count.load(std::memory_order_acquire) == 0)
+	{
+		return false;
+	}
+
+	// Pops newest task of own deque.
+	{
+		TaskDeque& own = *m_deque_list[index];
+		std::lock_guard<std::mutex> lock(own.mutex);
+		if (!own.task_list.empty())
+		{
+			task = own.task_list.back();
+			own.task_list.pop_back();
+			m_task_count.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+
+	// Steals oldest task of other deque.
+	for (int i = 1; i < m_thread_count; ++i)
+	{
+		TaskDeque& other = *m_deque_list[(index + i) % m_thread_count];
+		std::lock_guard<std::mutex> lock(other.mutex);
+		if (!other.task_list.empty())
+		{
+			task = other.task_list.front();
+			other.task_list.pop_front();
+			m_task_count.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+	return false;
+}
+
+} // namespace spaceless
@@ -0,0 +1,112 @@
+/**
+ * compute_pool.h
+ * @author wherewindblow
+ * @date   Mar 14, 2019
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+
+#include <lights/sequence.h>
+
+#include "basics.h"
+#include "actor_message.h"
+
+
+namespace spaceless {
+
+/**
+ * Thread pool that runs CPU-heavy function out of network thread and worker thread. Each thread has its own
+ * task deque. Thread pops task from back of its own deque and steals task from front of other deque when
+ * its own deque is empty, so busy thread never blocks idle thread.
+ */
+class ComputePool
+{
+public:
+	SPACELESS_SINGLETON_INSTANCE(ComputePool);
+
+	/**
+	 * Creates compute pool.
+	 */
+	ComputePool();
+
+	/**
+	 * Sets number of thread.
+	 * @note Must set before start.
+	 */
+	void set_thread_count(int count);
+
+	/**
+	 * Returns number of thread.
+	 */
+	int thread_count() const;
+
+	/**
+	 * Starts all threads.
+	 */
+	void start();
+
+	/**
+	 * Stops all threads and discards remaining task.
+	 * @note It'll block until all threads exit.
+	 */
+	void stop();
+
+	/**
+	 * Pushes function to pool. Pool owns function until it's run or discarded.
+	 */
+	void push(lights::StringView caller, DelegateFunction* function);
+
+	/**
+	 * Checks current thread is thread of pool.
+	 */
+	bool is_compute_thread() const;
+
+	/**
+	 * Returns number of task that is waiting to run.
+	 */
+	std::size_t size() const;
+
+private:
+	struct Task
+	{
+		DelegateFunction* function;
+		lights::StringView caller;
+	};
+
+	struct TaskDeque
+	{
+		std::mutex mutex;
+		std::deque<Task> task_list;
+	};
+
+	/**
+	 * Runs task until pool is stopped.
+	 */
+	void run(int index);
+
+	/**
+	 * Pops task from own deque or steals from other deque.
+	 * @return Returns false if have no task.
+	 */
+	bool pop_task(int index, Task& task);
+
+	int m_thread_count;
+	std::vector<std::unique_ptr<TaskDeque>> m_deque_list;
+	std::vector<std::thread> m_thread_list;
+	std::atomic<std::size_t> m_task_count;
+	std::atomic<std::size_t> m_next_deque;
+	std::atomic<bool> m_stop_flag;
+	std::mutex m_wait_mutex;
+	std::condition_variable m_wait_condition;
+};
+
+} // namespace spaceless
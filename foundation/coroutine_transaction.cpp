@@ -0,0 +1,162 @@
+/**
+ * coroutine_transaction.cpp
+ * @author wherewindblow
+ * @date   Mar 10, 2019
+ */
+
+#include "coroutine_transaction.h"
+
+#include "log.h"
+#include "size_class_pool.h"
+
+
+namespace spaceless {
+
+static Logger& logger = get_logger("worker");
+static thread_local lights::TextWriter error_msg;
+
+namespace details {
+
+const std::size_t FRAME_SIZE_ALIGN = 64;
+
+// Frame is allocated and deallocated in the same worker.
+static thread_local SizeClassPool frame_pool(COROUTINE_FRAME_MAX_POOL_SIZE,
+											 FRAME_SIZE_ALIGN,
+											 COROUTINE_FRAME_POOL_MAX_BLOCK);
+
+} // namespace details
+
+
+void* CoroutineFrameAllocator::allocate(std::size_t size)
+{
+	return details::frame_pool.allocate(size);
+}
+
+
+void CoroutineFrameAllocator::deallocate(void* frame, std::size_t size)
+{
+	details::frame_pool.deallocate(frame, size);
+}
+
+
+CoroutineTransaction::NextPhaseAwaiter::NextPhaseAwaiter(CoroutineTransaction& trans,
+														 int conn_id,
+														 int service_id,
+														 int cmd,
+														 int timeout_ms) :
+	m_trans(trans),
+	m_conn_id(conn_id),
+	m_service_id(service_id),
+	m_cmd(cmd),
+	m_timeout_ms(timeout_ms)
+{
+}
+
+
+void CoroutineTransaction::NextPhaseAwaiter::await_suspend(std::coroutine_handle<> handle)
+{
+	m_trans.wait_next_phase(m_conn_id, m_cmd, &CoroutineTransaction::on_resume, m_timeout_ms, m_service_id);
+	m_trans.m_is_awaiting = true;
+	m_trans.m_phase_error = ErrorInfo();
+}
+
+
+Package CoroutineTransaction::NextPhaseAwaiter::await_resume()
+{
+	m_trans.m_is_awaiting = false;
+	if (m_trans.m_phase_error.code != 0)
+	{
+		SPACELESS_THROW_ERROR_INFO(m_trans.m_phase_error);
+	}
+
+	Package package = m_trans.m_phase_package;
+	m_trans.m_phase_package = Package();
+	return package;
+}
+
+
+TransactionFatory CoroutineTransaction::make_factory(CoroutineHandler handler)
+{
+	return [handler](int trans_id)
+	{
+		return new CoroutineTransaction(trans_id, handler);
+	};
+}
+
+
+CoroutineTransaction::CoroutineTransaction(int trans_id, CoroutineHandler handler) :
+	MultiplyPhaseTransaction(trans_id),
+	m_handler(std::move(handler)),
+	m_handle(nullptr),
+	m_is_awaiting(false),
+	m_phase_package(),
+	m_phase_error()
+{
+}
+
+
+CoroutineTransaction::~CoroutineTransaction()
+{
+	if (m_handle)
+	{
+		m_handle.destroy();
+	}
+}
+
+
+void CoroutineTransaction::on_init(int conn_id, Package package)
+{
+	m_handle = m_handler(*this, conn_id, package).release();
+	std::exception_ptr exception = resume();
+	if (exception)
+	{
+		std::rethrow_exception(exception);
+	}
+}
+
+
+void CoroutineTransaction::on_error(int conn_id, const ErrorInfo& error_info)
+{
+	if (!m_is_awaiting)
+	{
+		MultiplyPhaseTransaction::on_error(conn_id, error_info);
+		return;
+	}
+
+	// Lets handler to handle error of waiting.
+	m_phase_error = error_info;
+	std::exception_ptr exception = resume();
+	if (!exception)
+	{
+		return;
+	}
+
+	ErrorInfo handler_error_info;
+	safe_call([&exception]() { std::rethrow_exception(exception); }, error_msg, &handler_error_info);
+	LIGHTS_ERROR(logger, "Connection {}: Transaction error. trans_id={}. {}.",
+				 conn_id, transaction_id(), error_msg.c_str());
+	MultiplyPhaseTransaction::on_error(conn_id, handler_error_info);
+}
+
+
+void CoroutineTransaction::on_resume(int conn_id, Package package)
+{
+	m_phase_package = package;
+	m_phase_error = ErrorInfo();
+	std::exception_ptr exception = resume();
+	if (exception)
+	{
+		std::rethrow_exception(exception);
+	}
+}
+
+
+std::exception_ptr CoroutineTransaction::resume()
+{
+	m_handle.resume();
+	std::exception_ptr exception = m_handle.promise().exception;
+	m_handle.promise().exception = nullptr;
+	return exception;
+}
+
+} // namespace spaceless
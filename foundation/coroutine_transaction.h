@@ -0,0 +1,277 @@
+/**
+ * coroutine_transaction.h
+ * @author wherewindblow
+ * @date   Mar 10, 2019
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <coroutine>
+#include <exception>
+#include <functional>
+
+#include "transaction.h"
+
+
+namespace spaceless {
+
+/**
+ * Allocator of coroutine frame. Frame is recycled by size class in each thread, so coroutine transaction
+ * never allocates memory for frame after warming up.
+ */
+class CoroutineFrameAllocator
+{
+public:
+	/**
+	 * Gets frame from pool of current thread or allocates new frame.
+	 */
+	static void* allocate(std::size_t size);
+
+	/**
+	 * Returns frame to pool of current thread.
+	 */
+	static void deallocate(void* frame, std::size_t size);
+};
+
+
+/**
+ * Return type of coroutine transaction handler. It owns coroutine frame until frame is released to transaction.
+ */
+class CoroutineTask
+{
+public:
+	struct promise_type
+	{
+		CoroutineTask get_return_object()
+		{
+			return CoroutineTask(std::coroutine_handle<promise_type>::from_promise(*this));
+		}
+
+		// Starts to run after transaction takes the frame.
+		std::suspend_always initial_suspend() noexcept
+		{
+			return {};
+		}
+
+		// Keeps frame after finish, so transaction can check exception and destroy frame.
+		std::suspend_always final_suspend() noexcept
+		{
+			return {};
+		}
+
+		void return_void()
+		{}
+
+		void unhandled_exception()
+		{
+			exception = std::current_exception();
+		}
+
+		static void* operator new(std::size_t size)
+		{
+			return CoroutineFrameAllocator::allocate(size);
+		}
+
+		static void operator delete(void* frame, std::size_t size)
+		{
+			CoroutineFrameAllocator::deallocate(frame, size);
+		}
+
+		std::exception_ptr exception;
+	};
+
+	using Handle = std::coroutine_handle<promise_type>;
+
+	CoroutineTask(CoroutineTask&& other) noexcept;
+
+	CoroutineTask(const CoroutineTask&) = delete;
+
+	CoroutineTask& operator=(const CoroutineTask&) = delete;
+
+	/**
+	 * Destroys frame if it's not released.
+	 */
+	~CoroutineTask();
+
+	/**
+	 * Releases ownership of frame.
+	 */
+	Handle release();
+
+private:
+	explicit CoroutineTask(Handle handle);
+
+	Handle m_handle;
+};
+
+
+class CoroutineTransaction;
+
+using CoroutineHandler = std::function<CoroutineTask(CoroutineTransaction& trans, int conn_id, Package package)>;
+
+
+/**
+ * Multiply phase transaction that write as coroutine. Handler uses @c co_await to wait next phase, so
+ * all phases are written as straight-line code.
+ * @note 1. Handler cannot hold reference of data that may be removed during waiting.
+ *       2. Timeout of waiting phase is thrown as exception in handler. Uncaught exception is handled by
+ *          @c on_error.
+ */
+class CoroutineTransaction final: public MultiplyPhaseTransaction
+{
+public:
+	/**
+	 * Awaiter of next phase. The result of awaiting is package of next phase.
+	 */
+	class NextPhaseAwaiter
+	{
+	public:
+		NextPhaseAwaiter(CoroutineTransaction& trans, int conn_id, int service_id, int cmd, int timeout_ms);
+
+		bool await_ready() const noexcept
+		{
+			return false;
+		}
+
+		void await_suspend(std::coroutine_handle<> handle);
+
+		/**
+		 * Returns package of next phase.
+		 * @throw Throws exception if waiting failure.
+		 */
+		Package await_resume();
+
+	private:
+		CoroutineTransaction& m_trans;
+		int m_conn_id;
+		int m_service_id;
+		int m_cmd;
+		int m_timeout_ms;
+	};
+
+	/**
+	 * Returns factory that create coroutine transaction with handler.
+	 */
+	static TransactionFatory make_factory(CoroutineHandler handler);
+
+	/**
+	 * Creates coroutine transaction.
+	 */
+	CoroutineTransaction(int trans_id, CoroutineHandler handler);
+
+	/**
+	 * Destroys coroutine frame.
+	 */
+	~CoroutineTransaction() override;
+
+	/**
+	 * Starts to run handler.
+	 */
+	void on_init(int conn_id, Package package) override;
+
+	/**
+	 * Resumes handler with error if it's waiting next phase. Otherwise sends error to first connection.
+	 */
+	void on_error(int conn_id, const ErrorInfo& error_info) override;
+
+	/**
+	 * Waits next phase of connection.
+	 */
+	NextPhaseAwaiter next_phase(int conn_id, int cmd, int timeout_ms = DEFAULT_TIMEOUT);
+
+	/**
+	 * Waits next phase of connection.
+	 */
+	NextPhaseAwaiter next_phase(int conn_id, const protocol::Message& msg, int timeout_ms = DEFAULT_TIMEOUT);
+
+	/**
+	 * Waits next phase of service.
+	 */
+	NextPhaseAwaiter service_next_phase(int service_id, int cmd, int timeout_ms = DEFAULT_TIMEOUT);
+
+	/**
+	 * Waits next phase of service.
+	 */
+	NextPhaseAwaiter service_next_phase(int service_id, const protocol::Message& msg, int timeout_ms = DEFAULT_TIMEOUT);
+
+private:
+	/**
+	 * Resumes handler with package of next phase.
+	 */
+	void on_resume(int conn_id, Package package);
+
+	/**
+	 * Resumes handler.
+	 * @return Returns exception that is thrown by handler.
+	 */
+	std::exception_ptr resume();
+
+	CoroutineHandler m_handler;
+	CoroutineTask::Handle m_handle;
+	bool m_is_awaiting;
+	Package m_phase_package;
+	ErrorInfo m_phase_error;
+};
+
+
+#define SPACELESS_REG_COROUTINE_TRANS(ProtocolType, handler) \
+		TransactionManager::instance()->register_multiply_phase_transaction(ProtocolType(), \
+			CoroutineTransaction::make_factory(handler))
+
+
+// ================================= Inline implement. =================================
+
+inline CoroutineTask::CoroutineTask(Handle handle) :
+	m_handle(handle)
+{}
+
+inline CoroutineTask::CoroutineTask(CoroutineTask&& other) noexcept :
+	m_handle(other.m_handle)
+{
+	other.m_handle = nullptr;
+}
+
+inline CoroutineTask::~CoroutineTask()
+{
+	if (m_handle)
+	{
+		m_handle.destroy();
+	}
+}
+
+inline CoroutineTask::Handle CoroutineTask::release()
+{
+	Handle handle = m_handle;
+	m_handle = nullptr;
+	return handle;
+}
+
+
+inline CoroutineTransaction::NextPhaseAwaiter CoroutineTransaction::next_phase(int conn_id, int cmd, int timeout_ms)
+{
+	return NextPhaseAwaiter(*this, conn_id, 0, cmd, timeout_ms);
+}
+
+inline CoroutineTransaction::NextPhaseAwaiter CoroutineTransaction::next_phase(int conn_id,
+																			   const protocol::Message& msg,
+																			   int timeout_ms)
+{
+	return next_phase(conn_id, protocol::get_command(msg), timeout_ms);
+}
+
+inline CoroutineTransaction::NextPhaseAwaiter CoroutineTransaction::service_next_phase(int service_id,
+																					   int cmd,
+																					   int timeout_ms)
+{
+	return NextPhaseAwaiter(*this, 0, service_id, cmd, timeout_ms);
+}
+
+inline CoroutineTransaction::NextPhaseAwaiter CoroutineTransaction::service_next_phase(int service_id,
+																					   const protocol::Message& msg,
+																					   int timeout_ms)
+{
+	return service_next_phase(service_id, protocol::get_command(msg), timeout_ms);
+}
+
+} // namespace spaceless
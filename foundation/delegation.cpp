@@ -6,12 +6,39 @@
 
 #include "delegation.h"
 #include "actor_message.h"
+#include "worker.h"
+#include "compute_pool.h"
+#include "network.h"
 
 
 namespace spaceless {
 
-void Delegation::delegate(lights::StringView caller, ActorTarget actor, std::function<void()> function)
+Delegation::Destination Delegation::current_destination()
 {
+	if (WorkerScheduler::instance()->is_worker_thread())
+	{
+		auto index = WorkerScheduler::instance()->current_worker_index();
+		return Destination{WORKER, static_cast<std::size_t>(index)};
+	}
+
+	if (ComputePool::instance()->is_compute_thread())
+	{
+		return Destination{COMPUTE, 0};
+	}
+
+	// Network runs in the thread that start scheduler.
+	return Destination{NETWORK, 0};
+}
+
+
+void Delegation::push_function(lights::StringView caller, Destination destination, DelegateFunction* function)
+{
+	if (destination.actor == COMPUTE)
+	{
+		ComputePool::instance()->push(caller, function);
+		return;
+	}
+
 	ActorMessage actor_msg;
 	actor_msg.type = ActorMessage::DELEGATE_TYPE;
 	auto& msg = actor_msg.delegate_msg;
@@ -19,12 +46,19 @@ void Delegation::delegate(lights::StringView caller, ActorTarget actor, std::fun
 	msg.caller = caller;
 
 	ActorMessageQueue::QueueType queue_type = ActorMessageQueue::OUT_QUEUE;
-	if (actor == ActorTarget::WORKER)
+	if (destination.actor == WORKER)
 	{
 		queue_type = ActorMessageQueue::IN_QUEUE;
+
+		// Network thread never waits worker, so worker can wait network when output queue is full.
+		if (NetworkManager::instance()->is_network_thread())
+		{
+			NetworkManager::instance()->push_to_worker(actor_msg, CommandPriority::NORMAL, destination.channel);
+			return;
+		}
 	}
 
-	ActorMessageQueue::instance()->push(queue_type, actor_msg);
+	ActorMessageQueue::instance()->push(queue_type, actor_msg, CommandPriority::NORMAL, destination.channel);
 }
 
 } // namespace spaceless
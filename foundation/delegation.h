@@ -6,9 +6,13 @@
 
 #pragma once
 
-#include <functional>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
 #include <lights/sequence.h>
 
+#include "actor_message.h"
+
 
 namespace spaceless {
 
@@ -19,11 +23,13 @@ public:
 	{
 		NETWORK,
 		WORKER,
+		COMPUTE, // Thread pool that runs CPU-heavy function.
 	};
 
 	/**
 	 * Let target actor to run delegate function.
-	 * @param actor         Specify the thread to run function.
+	 * @param actor         Specify the thread to run function. Worker target is the worker that call this
+	 *                      function, or the first worker if caller is not a worker.
 	 * @param function      Function that do something.
 	 * @param caller        Indicates who call this delegate.
 	 * @note 1. @c function cannot capture any structure or class by reference in current thread.
@@ -32,8 +38,82 @@ public:
 	 * Why use @c lights::SourceLocation to instead of @c where, because lambda cannot capture
 	 * more than two argument when use macro to expend current source location with
 	 * void delegate(ThreadTarget thread_target, std::function<void()> func, const lights::SourceLocation where).
+	 * Function is stored in pooled block, so small capture will not allocate memory.
+	 */
+	template <typename Function>
+	static void delegate(lights::StringView caller, ActorTarget actor, Function&& function);
+
+	/**
+	 * Runs @c compute in compute pool, and then runs @c continuation with result of @c compute in the actor
+	 * that call this function. Continuation of network thread or non-actor thread is run in network thread.
+	 * @param compute       Function that do CPU-heavy work. It cannot touch any data of actor.
+	 * @param continuation  Function that receive result. If @c compute returns void, it receives nothing.
+	 * @note Continuation will not be run if @c compute throws exception.
+	 * @note Continuation is pushed by compute thread, so message queue cannot be single producer.
+	 */
+	template <typename Compute, typename Continuation>
+	static void delegate_compute(lights::StringView caller, Compute&& compute, Continuation&& continuation);
+
+private:
+	/**
+	 * Target to run delegate function.
+	 */
+	struct Destination
+	{
+		ActorTarget actor;
+		std::size_t channel;
+	};
+
+	/**
+	 * Returns the actor that run in current thread.
 	 */
-	static void delegate(lights::StringView caller, ActorTarget actor, std::function<void()> function);
+	static Destination current_destination();
+
+	/**
+	 * Pushes delegate function to message queue of target actor.
+	 */
+	static void push_function(lights::StringView caller, Destination destination, DelegateFunction* function);
 };
 
+
+// ================================= Inline implement. =================================
+
+template <typename Function>
+inline void Delegation::delegate(lights::StringView caller, ActorTarget actor, Function&& function)
+{
+	Destination destination = {actor, 0};
+	if (actor == WORKER)
+	{
+		// Keeps function in the same worker if delegate by worker.
+		destination.channel = current_destination().channel;
+	}
+	push_function(caller, destination, DelegateFunction::create(std::forward<Function>(function)));
+}
+
+template <typename Compute, typename Continuation>
+inline void Delegation::delegate_compute(lights::StringView caller, Compute&& compute, Continuation&& continuation)
+{
+	Destination origin = current_destination();
+	delegate(caller, COMPUTE, [caller,
+							   origin,
+							   compute = std::forward<Compute>(compute),
+							   continuation = std::forward<Continuation>(continuation)]() mutable
+	{
+		if constexpr (std::is_void_v<std::invoke_result_t<Compute&>>)
+		{
+			compute();
+			push_function(caller, origin, DelegateFunction::create(std::move(continuation)));
+		}
+		else
+		{
+			auto result = compute();
+			push_function(caller, origin, DelegateFunction::create(
+				[continuation = std::move(continuation), result = std::move(result)]() mutable
+			{
+				continuation(std::move(result));
+			}));
+		}
+	});
+}
+
 } // namespace spaceless
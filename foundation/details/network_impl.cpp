@@ -7,13 +7,20 @@
 
 #include "network_impl.h"
 
+#include <sys/uio.h>
+#include <cerrno>
+
 #include <Poco/NObserver.h>
 #include <Poco/Net/NetException.h>
 #include <lights/precise_time.h>
+#include <protocol/command.h>
 
 #include "../log.h"
 #include "../network.h"
 #include "../actor_message.h"
+#include "../worker.h"
+#include "../thread_placement.h"
+#include "../rsa_key_pool.h"
 
 
 namespace spaceless {
@@ -25,6 +32,8 @@ static Logger& logger = get_logger("network");
 
 static lights::TextWriter error_msg;
 
+static thread_local bool is_in_network_thread = false;
+
 
 void dump_sequence(lights::Sequence sequence)
 {
@@ -43,6 +52,52 @@ void dump_sequence(lights::Sequence sequence)
 }
 
 
+/**
+ * Returns open type of peer of connection that is opened by @c open_type.
+ */
+ConnectionOpenType get_peer_open_type(ConnectionOpenType open_type)
+{
+	return open_type == ConnectionOpenType::ACTIVE_OPEN ? ConnectionOpenType::PASSIVE_OPEN :
+		ConnectionOpenType::ACTIVE_OPEN;
+}
+
+
+/**
+ * Copies data to content of stream package at offset. It's use to access content that may cross chunk.
+ */
+void write_stream_content(Package package, std::size_t offset, const char* data, std::size_t length)
+{
+	while (length != 0)
+	{
+		lights::Sequence chunk = package.segment(offset / Package::STREAM_CHUNK_LEN);
+		std::size_t chunk_offset = offset % Package::STREAM_CHUNK_LEN;
+		std::size_t len = std::min(chunk.length() - chunk_offset, length);
+		lights::copy_array(static_cast<char*>(chunk.data()) + chunk_offset, data, len);
+		offset += len;
+		data += len;
+		length -= len;
+	}
+}
+
+
+/**
+ * Copies content of stream package at offset to data. It's use to access content that may cross chunk.
+ */
+void read_stream_content(Package package, std::size_t offset, char* data, std::size_t length)
+{
+	while (length != 0)
+	{
+		lights::SequenceView chunk = package.segment(offset / Package::STREAM_CHUNK_LEN);
+		std::size_t chunk_offset = offset % Package::STREAM_CHUNK_LEN;
+		std::size_t len = std::min(chunk.length() - chunk_offset, length);
+		lights::copy_array(data, static_cast<const char*>(chunk.data()) + chunk_offset, len);
+		offset += len;
+		data += len;
+		length -= len;
+	}
+}
+
+
 void pad_message(ActorMessage::NetworkMsg& msg, int conn_id, int package_id)
 {
 	msg.conn_id = conn_id;
@@ -108,11 +163,15 @@ NetworkConnectionImpl::NetworkConnectionImpl(StreamSocket& socket,
 	m_socket(socket),
 	m_reactor(reactor),
 	m_open_type(open_type),
+	m_receive_stream(),
 	m_receive_len(0),
 	m_receive_state(ReceiveState::RECEIVE_HEADER),
 	m_send_len(0),
 	m_is_opening(true),
 	m_is_closing(false),
+	m_is_receive_paused(false),
+	m_is_msg_blocked(false),
+	m_blocked_msg(),
 	security_setting(SecuritySetting::OPEN_SECURITY),
 	m_secure_conn(nullptr),
 	m_pending_list(nullptr)
@@ -185,7 +244,19 @@ NetworkConnectionImpl::~NetworkConnectionImpl()
 		{
 			int package_id = m_send_list.front();
 			m_send_list.pop();
-			PackageManager::instance()->remove_package(package_id);
+			PackageManager::instance()->release_package(package_id);
+		}
+
+		if (m_receive_stream.is_valid())
+		{
+			PackageManager::instance()->release_package(m_receive_stream.package_id());
+			m_receive_stream = Package();
+		}
+
+		if (m_is_msg_blocked)
+		{
+			PackageManager::instance()->release_package(m_blocked_msg.msg.network_msg.package_id);
+			m_is_msg_blocked = false;
 		}
 
 		// Close socket.
@@ -211,6 +282,12 @@ NetworkConnectionImpl::~NetworkConnectionImpl()
 	// Remove pending list.
 	if (m_pending_list != nullptr)
 	{
+		while (!m_pending_list->empty())
+		{
+			PackageManager::instance()->release_package(m_pending_list->front());
+			m_pending_list->pop();
+		}
+
 		delete m_pending_list;
 		m_pending_list = nullptr;
 	}
@@ -237,14 +314,12 @@ void NetworkConnectionImpl::send_raw_package(Package package)
 	}
 
 	// Send package.
-	int len = static_cast<int>(package.valid_length());
-	m_send_len = m_socket.sendBytes(package.data(), len);
-	if (m_send_len == len)
+	if (send_remaining_data(package))
 	{
 		m_send_len = 0;
-		PackageManager::instance()->remove_package(package.package_id());
+		PackageManager::instance()->release_package(package.package_id());
 	}
-	else if (m_send_len < len)
+	else
 	{
 		m_send_list.push(package.package_id());
 		ConnectionObserver<WritableNotification> observer(*this, &NetworkConnectionImpl::on_writable, m_id);
@@ -259,7 +334,7 @@ void NetworkConnectionImpl::send_package(Package package)
 	{
 		LIGHTS_ERROR(logger, "Connection {}: Send package while closing. cmd={}, trigger_package_id={}.",
 					 m_id, package.header().base.command, package.header().extend.trigger_package_id);
-		PackageManager::instance()->remove_package(package.package_id());
+		PackageManager::instance()->release_package(package.package_id());
 		return;
 	}
 
@@ -332,14 +407,11 @@ void NetworkConnectionImpl::on_writable(const Poco::AutoPtr<WritableNotification
 	}
 
 	// Send package.
-	int len = static_cast<int>(package.valid_length());
-	m_send_len += m_socket.sendBytes(package.data() + m_send_len, len - m_send_len);
-
-	if (m_send_len == len)
+	if (send_remaining_data(package))
 	{
 		m_send_len = 0;
 		m_send_list.pop();
-		PackageManager::instance()->remove_package(package.package_id());
+		PackageManager::instance()->release_package(package.package_id());
 	}
 
 	if (m_send_list.empty())
@@ -411,6 +483,24 @@ void NetworkConnectionImpl::receive_for_state()
 					read_content_len = m_secure_conn->get_content_length(raw_len);
 				}
 
+				if (m_receive_len == 0 && !PackageManager::instance()->has_memory_budget(raw_len, m_id))
+				{
+					LIGHTS_INFO(logger, "Connection {}: Pause receive because package memory is over budget. "
+						"content_length={}.", m_id, raw_len);
+					pause_receive();
+					return;
+				}
+
+				// Large content is received into stream package directly to avoid contiguous buffer.
+				if (static_cast<std::size_t>(read_content_len) > PackageBuffer::MAX_CONTENT_LEN &&
+					static_cast<std::size_t>(read_content_len) <= Package::MAX_STREAM_CONTENT_LEN)
+				{
+					m_receive_stream = PackageManager::instance()->register_stream_package(raw_len, m_id);
+					m_receive_stream.header() = m_receive_buffer.header();
+					m_receive_state = ReceiveState::RECEIVE_STREAM_CONTENT;
+					break;
+				}
+
 				if (read_content_len != 0)
 				{
 					auto expect_len = static_cast<std::size_t>(read_content_len);
@@ -456,8 +546,128 @@ void NetworkConnectionImpl::receive_for_state()
 				}
 				break;
 			}
+
+			case ReceiveState::RECEIVE_STREAM_CONTENT:
+			{
+				if (!receive_stream_content())
+				{
+					return;
+				}
+				break;
+			}
+		}
+	}
+}
+
+
+bool NetworkConnectionImpl::receive_stream_content()
+{
+	int read_content_len = m_receive_stream.header().base.content_length;
+	if (m_secure_conn != nullptr)
+	{
+		read_content_len = m_secure_conn->get_content_length(read_content_len);
+	}
+
+	// Segment of receive stream is fixed length except the last one, so can locate it by offset.
+	auto offset = static_cast<std::size_t>(m_receive_len);
+	lights::Sequence chunk = m_receive_stream.segment(offset / Package::STREAM_CHUNK_LEN);
+	std::size_t chunk_offset = offset % Package::STREAM_CHUNK_LEN;
+	std::size_t expect_len = std::min(chunk.length() - chunk_offset, static_cast<std::size_t>(read_content_len) - offset);
+
+	int len = m_socket.receiveBytes(static_cast<char*>(chunk.data()) + chunk_offset, static_cast<int>(expect_len));
+	if (len == -1) // Not available bytes in buffer.
+	{
+		return false;
+	}
+
+	if (len == 0) // Closes by peer.
+	{
+		close_without_waiting();
+		return false;
+	}
+
+	m_receive_len += len;
+	if (m_receive_len == read_content_len)
+	{
+		m_receive_len = 0;
+		m_receive_state = ReceiveState::RECEIVE_HEADER;
+
+		Package package = m_receive_stream;
+		m_receive_stream = Package();
+		return on_receive_complete_stream_package(package);
+	}
+	return true;
+}
+
+
+void NetworkConnectionImpl::pause_receive()
+{
+	ConnectionObserver<ReadableNotification> readable(*this, &NetworkConnectionImpl::on_readable, m_id);
+	m_reactor.removeEventHandler(m_socket, readable);
+	m_is_receive_paused = true;
+	NetworkManagerImpl::instance()->on_pause_receive(m_id);
+}
+
+
+bool NetworkConnectionImpl::resume_receive()
+{
+	if (!m_is_receive_paused)
+	{
+		return true;
+	}
+
+	if (m_is_msg_blocked)
+	{
+		if (!ActorMessageQueue::instance()->try_push(ActorMessageQueue::IN_QUEUE,
+													 m_blocked_msg.msg,
+													 m_blocked_msg.priority,
+													 m_blocked_msg.worker_index))
+		{
+			return false;
 		}
+		m_is_msg_blocked = false;
+	}
+
+	// Budget is only checked before receive content.
+	if (m_receive_state == ReceiveState::RECEIVE_CONTENT &&
+		!PackageManager::instance()->has_memory_budget(m_receive_buffer.header().base.content_length, m_id))
+	{
+		return false;
+	}
+
+	LIGHTS_INFO(logger, "Connection {}: Resume receive.", m_id);
+	ConnectionObserver<ReadableNotification> readable(*this, &NetworkConnectionImpl::on_readable, m_id);
+	m_reactor.addEventHandler(m_socket, readable);
+	m_is_receive_paused = false;
+	return true;
+}
+
+
+bool NetworkConnectionImpl::push_to_worker(Package package)
+{
+	ActorMessage msg;
+	msg.type = ActorMessage::NETWORK_TYPE;
+	pad_message(msg.network_msg, m_id, package.package_id());
+	msg.network_msg.push_time_us = lights::to_microsecond(lights::current_monotonic_time());
+	// Converts relative time budget to local deadline, so waiting in queue is count in.
+	int time_budget_ms = package.header().extend.time_budget_ms;
+	if (time_budget_ms > 0)
+	{
+		package.set_deadline_us(msg.network_msg.push_time_us + lights::millisecond_to_microsecond(time_budget_ms));
+	}
+	CommandPriority priority = protocol::get_command_priority(package.header().base.command);
+	auto worker_index = static_cast<std::size_t>(WorkerScheduler::instance()->dispatch_worker(m_id, package));
+	if (ActorMessageQueue::instance()->try_push(ActorMessageQueue::IN_QUEUE, msg, priority, worker_index))
+	{
+		return true;
 	}
+
+	LIGHTS_INFO(logger, "Connection {}: Pause receive because input queue of worker is full. worker_index={}.",
+				m_id, worker_index);
+	m_blocked_msg = WorkerMessage{msg, priority, worker_index};
+	m_is_msg_blocked = true;
+	pause_receive();
+	return false;
 }
 
 
@@ -549,20 +759,102 @@ bool NetworkConnectionImpl::on_receive_complete_package(const PackageBuffer& pac
 	// Receive general package.
 	if (m_secure_conn != nullptr)
 	{
-		m_secure_conn->on_receive_complete_package(package_buffer);
+		return m_secure_conn->on_receive_complete_package(package_buffer);
 	}
 	else
 	{
 		int content_len = package_buffer.header().base.content_length;
-		Package package = PackageManager::instance()->register_package(content_len);
+		Package package = PackageManager::instance()->register_package(content_len, m_id);
 		lights::copy_array(package.data(), package_buffer.data(), package_buffer.valid_length());
 
-		ActorMessage msg;
-		msg.type = ActorMessage::NETWORK_TYPE;
-		pad_message(msg.network_msg, m_id, package.package_id());
-		ActorMessageQueue::instance()->push(ActorMessageQueue::IN_QUEUE, msg);
+		return push_to_worker(package);
 	}
-	return true;
+}
+
+
+bool NetworkConnectionImpl::on_receive_complete_stream_package(Package package)
+{
+	const PackageHeader& header = package.header();
+	LIGHTS_DEBUG(logger, "Connection {}: Receive stream package. cmd={}, trigger_package_id={}.",
+				 m_id, header.base.command, header.extend.trigger_package_id);
+
+	// Build-in command is always small and cannot use stream package.
+	if (m_is_opening)
+	{
+		LIGHTS_INFO(logger, "Connection {}: Ignore package when connection is opening. cmd={}.", m_id, header.base.command);
+		PackageManager::instance()->release_package(package.package_id());
+		return false;
+	}
+
+	if (m_secure_conn != nullptr)
+	{
+		return m_secure_conn->on_receive_complete_stream_package(package);
+	}
+	else
+	{
+		return push_to_worker(package);
+	}
+}
+
+
+bool NetworkConnectionImpl::send_remaining_data(Package package)
+{
+	auto total_len = static_cast<int>(package.valid_length());
+	if (!package.is_stream())
+	{
+		int len = m_socket.sendBytes(package.data() + m_send_len, total_len - m_send_len);
+		if (len > 0)
+		{
+			m_send_len += len;
+		}
+		return m_send_len == total_len;
+	}
+
+	// Gathers remaining header and segments to send by one system call until socket send buffer is full.
+	std::vector<lights::SequenceView> buffer_list = package.buffer_list();
+	while (m_send_len < total_len)
+	{
+		iovec iov_list[MAX_GATHER_BUFFER];
+		int iov_count = 0;
+		auto skip_len = static_cast<std::size_t>(m_send_len);
+		for (std::size_t i = 0; i < buffer_list.size() && iov_count < MAX_GATHER_BUFFER; ++i)
+		{
+			lights::SequenceView buffer = buffer_list[i];
+			if (skip_len >= buffer.length())
+			{
+				skip_len -= buffer.length();
+				continue;
+			}
+
+			iov_list[iov_count].iov_base = const_cast<char*>(static_cast<const char*>(buffer.data()) + skip_len);
+			iov_list[iov_count].iov_len = buffer.length() - skip_len;
+			skip_len = 0;
+			++iov_count;
+		}
+
+		std::size_t expect_len = 0;
+		for (int i = 0; i < iov_count; ++i)
+		{
+			expect_len += iov_list[i].iov_len;
+		}
+
+		ssize_t len = ::writev(m_socket.impl()->sockfd(), iov_list, iov_count);
+		if (len < 0)
+		{
+			if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+			{
+				break;
+			}
+			throw Poco::Net::NetException("Gather write failure", errno);
+		}
+
+		m_send_len += static_cast<int>(len);
+		if (static_cast<std::size_t>(len) < expect_len)
+		{
+			break;
+		}
+	}
+	return m_send_len == total_len;
 }
 
 
@@ -594,12 +886,20 @@ SecureConnection::SecureConnection(NetworkConnectionImpl* conn) :
 	m_state(State::STARTING),
 	m_private_key(nullptr),
 	m_aes_key("", crypto::AesKeyBits::BITS_256),
+	m_encryptor(),
+	m_decryptor(),
+	m_send_sequence(0),
+	m_receive_sequence(0),
 	m_pending_list(nullptr)
 {
 	if (m_conn->open_type() == ConnectionOpenType::PASSIVE_OPEN)
 	{
-		// Generate RSA key pair.
-		crypto::RsaKeyPair key_pair = crypto::generate_rsa_key_pair();
+		// Take pre-generated RSA key pair. Generate it here only when pool is dry.
+		crypto::RsaKeyPair key_pair;
+		if (!RsaKeyPool::instance()->take(key_pair))
+		{
+			key_pair = crypto::generate_rsa_key_pair();
+		}
 		m_private_key = new crypto::RsaPrivateKey(key_pair.private_key);
 		std::string public_key = key_pair.public_key.save_to_string();
 		int content_len = static_cast<int>(public_key.length());
@@ -628,6 +928,12 @@ SecureConnection::~SecureConnection()
 
 	if (m_pending_list != nullptr)
 	{
+		while (!m_pending_list->empty())
+		{
+			PackageManager::instance()->release_package(m_pending_list->front());
+			m_pending_list->pop();
+		}
+
 		delete m_pending_list;
 		m_pending_list = nullptr;
 	}
@@ -647,27 +953,50 @@ void SecureConnection::send_package(Package package)
 		return;
 	}
 
-	// Encrypt package.
-	crypto::AesBlockEncryptor encryptor;
-	encryptor.set_key(m_aes_key);
+	// Shared package is also sending by other connection and external segment cannot be modified,
+	// so cannot encrypt it in-place.
+	if (PackageManager::instance()->is_shared_package(package.package_id()) || package.has_external_segment())
+	{
+		Package private_package = PackageManager::instance()->copy_package(package);
+		PackageManager::instance()->release_package(package.package_id());
+		package = private_package;
+	}
 
-	int content_len = package.header().base.content_length;
-	std::size_t cipher_len = static_cast<std::size_t>(get_content_length(content_len));
+	// Encrypt content and authenticate header, so peer can find out any modification of package.
+	auto content_len = static_cast<std::size_t>(package.header().base.content_length);
+	m_encryptor.start(next_iv(m_conn->open_type(), m_send_sequence));
+	m_encryptor.authenticate(reinterpret_cast<const char*>(&package.header()), Package::HEADER_LEN);
 
-	// In-place encryption that must ensure content have enough memory to do this.
-	lights::Sequence content = package.content();
-	for (std::size_t i = 0; i + crypto::AES_BLOCK_SIZE <= cipher_len; i += crypto::AES_BLOCK_SIZE)
+	// In-place encryption that must ensure content have enough memory to append tag.
+	char tag[crypto::AES_GCM_TAG_SIZE];
+	if (package.is_stream())
+	{
+		std::size_t left_len = content_len;
+		for (std::size_t n = 0; n < package.segment_count() && left_len != 0; ++n)
+		{
+			lights::Sequence chunk = package.segment(n);
+			std::size_t len = std::min(chunk.length(), left_len);
+			m_encryptor.encrypt(static_cast<char*>(chunk.data()), len);
+			left_len -= len;
+		}
+		m_encryptor.finish(tag);
+		write_stream_content(package, content_len, tag, sizeof(tag));
+	}
+	else
 	{
-		encryptor.encrypt(&content.at<char>(i));
+		auto content = static_cast<char*>(package.content_buffer().data());
+		m_encryptor.encrypt(content, content_len);
+		m_encryptor.finish(tag);
+		lights::copy_array(content + content_len, tag, sizeof(tag));
 	}
 
-	package.set_calculate_length(crypto::aes_cipher_length);
+	package.set_calculate_length(crypto::aes_gcm_cipher_length);
 
 	m_conn->send_raw_package(package);
 }
 
 
-void SecureConnection::on_receive_complete_package(const PackageBuffer& package_buffer)
+bool SecureConnection::on_receive_complete_package(const PackageBuffer& package_buffer)
 {
 	const PackageHeader& header = package_buffer.header();
 	switch (m_state)
@@ -685,6 +1014,7 @@ void SecureConnection::on_receive_complete_package(const PackageBuffer& package_
 				std::string cipher(static_cast<const char*>(content.data()), content.length());
 				std::string plain = rsa_decrypt(cipher, *m_private_key);
 				m_aes_key.reset(plain, crypto::AesKeyBits::BITS_256);
+				set_cipher();
 
 				// Remove key, because it's not necessary.
 				delete m_private_key;
@@ -705,6 +1035,7 @@ void SecureConnection::on_receive_complete_package(const PackageBuffer& package_
 
 				// Generate random AES key.
 				m_aes_key.reset(crypto::AesKeyBits::BITS_256);
+				set_cipher();
 
 				// Encrypt AES key.
 				std::string cipher = rsa_encrypt(m_aes_key.get_value(), public_key);
@@ -735,29 +1066,101 @@ void SecureConnection::on_receive_complete_package(const PackageBuffer& package_
 
 		case State::STARTED:
 		{
-			// Decrypt package.
+			// Decrypt package from receive buffer to package directly. Tag is following content.
 			lights::SequenceView content = package_buffer.content();
-			int content_len = get_content_length(static_cast<int>(content.length()));
-			Package package = PackageManager::instance()->register_package(content_len);
+			auto cipher = static_cast<const char*>(content.data());
+			Package package = PackageManager::instance()->register_package(header.base.content_length,
+																		   m_conn->connection_id());
 			package.header() = header;
-			lights::SequenceView cipher(content.data(), static_cast<std::size_t>(content_len));
-			crypto::aes_decrypt(cipher, package.content_buffer(), m_aes_key);
+			m_decryptor.start(next_iv(get_peer_open_type(m_conn->open_type()), m_receive_sequence));
+			m_decryptor.authenticate(reinterpret_cast<const char*>(&header), Package::HEADER_LEN);
+			m_decryptor.decrypt(cipher, static_cast<char*>(package.content_buffer().data()), content.length());
+			if (!m_decryptor.finish(cipher + content.length()))
+			{
+				PackageManager::instance()->release_package(package.package_id());
+				on_verify_failure(header);
+				return false;
+			}
 
 			// Push to in queue.
-			ActorMessage msg;
-			msg.type = ActorMessage::NETWORK_TYPE;
-			pad_message(msg.network_msg, m_conn->connection_id(), package.package_id());
-			ActorMessageQueue::instance()->push(ActorMessageQueue::IN_QUEUE, msg);
-			break;
+			return m_conn->push_to_worker(package);
 		}
 	}
+	return true;
+}
+
+
+bool SecureConnection::on_receive_complete_stream_package(Package package)
+{
+	if (m_state != State::STARTED)
+	{
+		// Ignore package when not started secure connection.
+		LIGHTS_INFO(logger, "Connection {}: Ignore package. cmd={}, trigger_package_id={}.",
+					m_conn->connection_id(), package.header().base.command, package.header().extend.trigger_package_id);
+		PackageManager::instance()->release_package(package.package_id());
+		return true;
+	}
+
+	// Decrypt package in-place.
+	auto content_len = static_cast<std::size_t>(package.header().base.content_length);
+	m_decryptor.start(next_iv(get_peer_open_type(m_conn->open_type()), m_receive_sequence));
+	m_decryptor.authenticate(reinterpret_cast<const char*>(&package.header()), Package::HEADER_LEN);
+	std::size_t left_len = content_len;
+	for (std::size_t n = 0; n < package.segment_count() && left_len != 0; ++n)
+	{
+		lights::Sequence chunk = package.segment(n);
+		std::size_t len = std::min(chunk.length(), left_len);
+		m_decryptor.decrypt(static_cast<char*>(chunk.data()), len);
+		left_len -= len;
+	}
+
+	char tag[crypto::AES_GCM_TAG_SIZE];
+	read_stream_content(package, content_len, tag, sizeof(tag));
+	if (!m_decryptor.finish(tag))
+	{
+		on_verify_failure(package.header());
+		PackageManager::instance()->release_package(package.package_id());
+		return false;
+	}
+
+	// Push to in queue.
+	return m_conn->push_to_worker(package);
 }
 
 
 int SecureConnection::get_content_length(int raw_length)
 {
 	auto plain_len = static_cast<std::size_t>(raw_length);
-	return static_cast<int>(crypto::aes_cipher_length(plain_len));
+	return static_cast<int>(crypto::aes_gcm_cipher_length(plain_len));
+}
+
+
+void SecureConnection::set_cipher()
+{
+	m_encryptor.set_key(m_aes_key);
+	m_decryptor.set_key(m_aes_key);
+}
+
+
+crypto::AesGcmIv SecureConnection::next_iv(ConnectionOpenType sender_open_type, std::uint64_t& sequence)
+{
+	crypto::AesGcmIv iv;
+	iv.fill(0);
+	iv[0] = sender_open_type == ConnectionOpenType::ACTIVE_OPEN ? 0 : 1;
+	for (std::size_t i = 0; i < sizeof(sequence); ++i)
+	{
+		iv[iv.size() - 1 - i] = static_cast<crypto::byte>(sequence >> (i * 8));
+	}
+	++sequence;
+	return iv;
+}
+
+
+void SecureConnection::on_verify_failure(const PackageHeader& header)
+{
+	LIGHTS_ERROR(logger, "Connection {}: Package is failure to verify, close connection. cmd={}, content_length={}.",
+				 m_conn->connection_id(), header.base.command, header.base.content_length);
+	m_conn->close();
 }
 
 
@@ -787,6 +1190,8 @@ void SecureConnection::send_all_pending_package()
 void NetworkReactor::onIdle()
 {
 	process_out_message();
+	process_blocked_message();
+	process_paused_connection();
 	// SocketReactor::onIdle(); // Avoid sending event to all network connection, because it's not efficient.
 }
 
@@ -794,6 +1199,8 @@ void NetworkReactor::onIdle()
 void NetworkReactor::onBusy()
 {
 	process_out_message();
+	process_blocked_message();
+	process_paused_connection();
 	// SocketReactor::onBusy(); // There is nothing in this function.
 }
 
@@ -801,20 +1208,21 @@ void NetworkReactor::onBusy()
 void NetworkReactor::onTimeout()
 {
 	process_out_message();
+	process_blocked_message();
+	process_paused_connection();
 	// SocketReactor::onTimeout(); // Avoid sending event to all network connection, because it's not efficient.
 }
 
 
 void NetworkReactor::process_out_message()
 {
-	for (std::size_t i = 0; i < REACTOR_MAX_MSG_PER_TIMES; ++i)
+	ActorMessage msg_list[REACTOR_MAX_MSG_PER_TIMES];
+	std::size_t count = ActorMessageQueue::instance()->pop(ActorMessageQueue::OUT_QUEUE,
+														   msg_list,
+														   REACTOR_MAX_MSG_PER_TIMES);
+	for (std::size_t i = 0; i < count; ++i)
 	{
-		if (ActorMessageQueue::instance()->empty(ActorMessageQueue::OUT_QUEUE))
-		{
-			break;
-		}
-
-		auto actor_msg = ActorMessageQueue::instance()->pop(ActorMessageQueue::OUT_QUEUE);
+		auto& actor_msg = msg_list[i];
 		switch (actor_msg.type)
 		{
 			case ActorMessage::NETWORK_TYPE:
@@ -827,10 +1235,11 @@ void NetworkReactor::process_out_message()
 			case ActorMessage::DELEGATE_TYPE:
 			{
 				auto& msg = actor_msg.delegate_msg;
-				if (!safe_call(msg.function, error_msg))
+				if (!safe_call([&msg]() { (*msg.function)(); }, error_msg))
 				{
 					LIGHTS_ERROR(logger, "Delegation {}: {}.", msg.caller, error_msg.c_str());
 				}
+				DelegateFunction::destroy(msg.function);
 				break;
 			}
 		}
@@ -838,6 +1247,42 @@ void NetworkReactor::process_out_message()
 }
 
 
+void NetworkReactor::process_paused_connection()
+{
+	auto& paused_conn_list = NetworkManagerImpl::instance()->m_paused_conn_list;
+	for (auto itr = paused_conn_list.begin(); itr != paused_conn_list.end();)
+	{
+		NetworkConnectionImpl* conn = NetworkManagerImpl::instance()->find_connection(*itr);
+		if (conn == nullptr || conn->resume_receive())
+		{
+			itr = paused_conn_list.erase(itr);
+		}
+		else
+		{
+			++itr;
+		}
+	}
+}
+
+
+void NetworkReactor::process_blocked_message()
+{
+	auto& blocked_msg_list = NetworkManagerImpl::instance()->m_blocked_msg_list;
+	while (!blocked_msg_list.empty())
+	{
+		WorkerMessage& blocked_msg = blocked_msg_list.front();
+		if (!ActorMessageQueue::instance()->try_push(ActorMessageQueue::IN_QUEUE,
+													 blocked_msg.msg,
+													 blocked_msg.priority,
+													 blocked_msg.worker_index))
+		{
+			break;
+		}
+		blocked_msg_list.pop();
+	}
+}
+
+
 void NetworkReactor::send_package(int conn_id, int service_id, int package_id)
 {
 	if (conn_id == 0)
@@ -862,7 +1307,7 @@ void NetworkReactor::send_package(int conn_id, int service_id, int package_id)
 
 		if (package.is_valid())
 		{
-			PackageManager::instance()->remove_package(package_id);
+			PackageManager::instance()->release_package(package_id);
 		}
 
 		return;
@@ -964,6 +1409,8 @@ void NetworkManagerImpl::stop_all()
 void NetworkManagerImpl::start()
 {
 	LIGHTS_INFO(logger, "Starting network scheduler.");
+	is_in_network_thread = true;
+	ThreadPlacement::instance()->apply(ThreadType::NETWORK, 0, "Network");
 	Poco::Timespan time_span(0, lights::millisecond_to_microsecond(REACTOR_TIMEOUT_MS));
 	m_reactor.setTimeout(time_span);
 	m_reactor.run();
@@ -978,6 +1425,24 @@ void NetworkManagerImpl::stop()
 }
 
 
+bool NetworkManagerImpl::is_network_thread() const
+{
+	return is_in_network_thread;
+}
+
+
+void NetworkManagerImpl::push_to_worker(const ActorMessage& msg, CommandPriority priority, std::size_t worker_index)
+{
+	// Keeps order of message that is behind blocked message.
+	if (m_blocked_msg_list.empty() &&
+		ActorMessageQueue::instance()->try_push(ActorMessageQueue::IN_QUEUE, msg, priority, worker_index))
+	{
+		return;
+	}
+	m_blocked_msg_list.push(WorkerMessage{msg, priority, worker_index});
+}
+
+
 int NetworkManagerImpl::on_create_connection(NetworkConnectionImpl* conn)
 {
 	int conn_id = m_next_id;
@@ -990,6 +1455,13 @@ int NetworkManagerImpl::on_create_connection(NetworkConnectionImpl* conn)
 void NetworkManagerImpl::on_destroy_connection(int conn_id)
 {
 	m_conn_list.erase(conn_id);
+	m_paused_conn_list.erase(conn_id);
+}
+
+
+void NetworkManagerImpl::on_pause_receive(int conn_id)
+{
+	m_paused_conn_list.insert(conn_id);
 }
 
 
@@ -17,6 +17,7 @@
 
 #include "../basics.h"
 #include "../package.h"
+#include "../actor_message.h"
 
 
 namespace spaceless {
@@ -46,6 +47,17 @@ enum class ConnectionOpenType
 };
 
 
+/**
+ * Message that waits to push to input queue of worker, because lane of input queue is full.
+ */
+struct WorkerMessage
+{
+	ActorMessage msg;
+	CommandPriority priority;
+	std::size_t worker_index;
+};
+
+
 /**
  * NetworkConnection handler socket notification and cache receive message.
  * @note Only operate this class in the thread that run @ NetworkConnectionManager::run.
@@ -83,11 +95,13 @@ public:
 
 	/**
 	 * Sends raw package to remote asynchronously.
+	 * @note Takes over one reference of package and release it after sending.
 	 */
 	void send_raw_package(Package package);
 
 	/**
 	 * Sends package that append additional process to remote asynchronously.
+	 * @note Takes over one reference of package and release it after sending.
 	 */
 	void send_package(Package package);
 
@@ -102,11 +116,29 @@ public:
 	 */
 	bool is_open() const;
 
+	/**
+	 * Resumes receive if blocked message is pushed to worker and have enough package memory budget.
+	 * @return Returns true if receive is resumed.
+	 */
+	bool resume_receive();
+
+	/**
+	 * Pushes received package to worker that dispatched by shard key. If input queue of worker is full, holds
+	 * message and pauses receive until it's pushed. So peer is blocked by flow control of TCP and network thread
+	 * never waits worker.
+	 * @return Returns false if receive is paused.
+	 */
+	bool push_to_worker(Package package);
+
 private:
+	// Max number of buffer that send by one gather write.
+	static const int MAX_GATHER_BUFFER = 64;
+
 	enum class ReceiveState
 	{
 		RECEIVE_HEADER,
 		RECEIVE_CONTENT,
+		RECEIVE_STREAM_CONTENT,
 	};
 
 	/**
@@ -134,11 +166,33 @@ private:
 	 */
 	bool process_check_package_version(int receive_len);
 
+	/**
+	 * Receives content of stream package incrementally.
+	 */
+	bool receive_stream_content();
+
+	/**
+	 * Stops reading socket until have enough package memory budget and blocked message is pushed.
+	 * So peer will be blocked by flow control of TCP.
+	 */
+	void pause_receive();
+
 	/**
 	 * On receive a complete package event.
 	 */
 	bool on_receive_complete_package(const PackageBuffer& package_buffer);
 
+	/**
+	 * On receive a complete stream package event.
+	 */
+	bool on_receive_complete_stream_package(Package package);
+
+	/**
+	 * Sends remaining data of package that start from @c m_send_len. Stream package is sent by gather write.
+	 * @return Returns true if all data of package is sent.
+	 */
+	bool send_remaining_data(Package package);
+
 	/**
 	 * Sends all pending package.
 	 */
@@ -154,12 +208,16 @@ private:
 	SocketReactor& m_reactor;
 	ConnectionOpenType m_open_type;
 	PackageBuffer m_receive_buffer;
+	Package m_receive_stream;
 	int m_receive_len;
 	ReceiveState m_receive_state;
 	std::queue<int> m_send_list;
 	int m_send_len;
 	bool m_is_opening;
 	bool m_is_closing;
+	bool m_is_receive_paused;
+	bool m_is_msg_blocked;
+	WorkerMessage m_blocked_msg; // Message that cannot push to full input queue. It's valid if m_is_msg_blocked.
 	SecuritySetting security_setting;
 	SecureConnection* m_secure_conn;
 	std::queue<int>* m_pending_list;
@@ -189,13 +247,21 @@ public:
 
 	/**
 	 * Sends package.
+	 * @note Shared package will be copied before in-place encryption.
 	 */
 	void send_package(Package package);
 
 	/**
 	 * On receive a complete package.
+	 * @return Returns false if connection is closed or receive is paused.
 	 */
-	void on_receive_complete_package(const PackageBuffer& package_buffer);
+	bool on_receive_complete_package(const PackageBuffer& package_buffer);
+
+	/**
+	 * On receive a complete stream package. Stream package will be decrypted in-place.
+	 * @return Returns false if connection is closed or receive is paused.
+	 */
+	bool on_receive_complete_stream_package(Package package);
 
 	/**
 	 * Gets content length that process with security.
@@ -214,10 +280,30 @@ private:
 	 */
 	void send_all_pending_package();
 
+	/**
+	 * Expands key schedule once, so sending and receiving package never expand it again.
+	 */
+	void set_cipher();
+
+	/**
+	 * Returns IV of next package that sent by side of @c sender_open_type and increases sequence. Each connection
+	 * has its own random key and IV consists of sender and sequence of package, so IV is never reused.
+	 */
+	crypto::AesGcmIv next_iv(ConnectionOpenType sender_open_type, std::uint64_t& sequence);
+
+	/**
+	 * Closes connection because package is failure to verify.
+	 */
+	void on_verify_failure(const PackageHeader& header);
+
 	NetworkConnectionImpl* m_conn;
 	State m_state;
 	crypto::RsaPrivateKey* m_private_key;
 	crypto::AesKey m_aes_key;
+	crypto::AesGcmEncryptor m_encryptor;
+	crypto::AesGcmDecryptor m_decryptor;
+	std::uint64_t m_send_sequence; // Sequence of package of each direction is also checked implicitly by IV.
+	std::uint64_t m_receive_sequence;
 	std::queue<int>* m_pending_list;
 };
 
@@ -241,6 +327,16 @@ public:
 	void onTimeout() override;
 
 private:
+	/**
+	 * Resumes connections that pause receive because of package memory budget or full input queue.
+	 */
+	void process_paused_connection();
+
+	/**
+	 * Pushes message that is blocked by full input queue to worker.
+	 */
+	void process_blocked_message();
+
 	/**
 	 * Process message that from worker thread.
 	 */
@@ -310,8 +406,21 @@ public:
 	 */
 	void stop();
 
+	/**
+	 * Checks current thread is network thread.
+	 */
+	bool is_network_thread() const;
+
+	/**
+	 * Pushes message to worker without waiting. If input queue of worker is full, message is kept in order
+	 * and pushed later by network thread.
+	 * @note Only use in network thread.
+	 */
+	void push_to_worker(const ActorMessage& msg, CommandPriority priority, std::size_t worker_index);
+
 private:
 	friend class NetworkConnectionImpl;
+	friend class NetworkReactor;
 
 	/**
 	 * On create connection event.
@@ -323,6 +432,11 @@ private:
 	 */
 	void on_destroy_connection(int conn_id);
 
+	/**
+	 * On connection pause receive event.
+	 */
+	void on_pause_receive(int conn_id);
+
 	/**
 	 * Gets security setting from socket address.
 	 */
@@ -332,6 +446,8 @@ private:
 	std::map<int, NetworkConnectionImpl*> m_conn_list;
 	std::list<SocketAcceptor<NetworkConnectionImpl>> m_acceptor_list;
 	std::set<std::string> m_secure_listener_list;
+	std::set<int> m_paused_conn_list;
+	std::queue<WorkerMessage> m_blocked_msg_list;
 	NetworkReactor m_reactor;
 };
 
@@ -41,7 +41,7 @@ const lights::ErrorCodeDescriptions& ErrorCodeCategory::descriptions(int code) c
 } // namespace details
 
 
-bool safe_call(std::function<void()> function, lights::TextWriter& error_msg, ErrorInfo* error_info)
+bool safe_call(FunctionRef<void()> function, lights::TextWriter& error_msg, ErrorInfo* error_info)
 {
 	error_msg.clear();
 	auto sink = lights::make_format_sink(error_msg);
@@ -11,6 +11,8 @@
 #include <functional>
 #include <lights/exception.h>
 
+#include "function_ref.h"
+
 
 namespace lights {
 
@@ -107,9 +109,24 @@ inline ErrorInfo to_error_info(int code)
 
 #define SPACELESS_THROW(code) LIGHTS_THROW(Exception, code)
 
+/**
+ * Throws exception that error info describes, so category of error is kept.
+ */
+[[noreturn]] inline void throw_error_info(const lights::SourceLocation& occur_location, const ErrorInfo& error_info)
+{
+	if (error_info.category == ErrorCategory::LIGHTS)
+	{
+		throw lights::Exception(occur_location, error_info.code);
+	}
+	throw Exception(occur_location, error_info.code);
+}
+
+#define SPACELESS_THROW_ERROR_INFO(error_info) throw_error_info(LIGHTS_CURRENT_SOURCE_LOCATION, error_info)
+
 /**
  * Call function without throw exception.
+ * @note Function is only referenced during calling, so passing lambda never allocates memory.
  */
-bool safe_call(std::function<void()> function, lights::TextWriter& error_msg, ErrorInfo* error_info = nullptr);
+bool safe_call(FunctionRef<void()> function, lights::TextWriter& error_msg, ErrorInfo* error_info = nullptr);
 
 } // namespace spaceless
@@ -0,0 +1,133 @@
+/**
+ * function_ref.h
+ * @author wherewindblow
+ * @date   Mar 21, 2019
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+
+namespace spaceless {
+
+template <typename Signature>
+class FunctionRef;
+
+/**
+ * Non-owning reference of callable object. It never allocates memory, so it's used as parameter of function
+ * that only calls callable object before return instead of @c std::function.
+ * @note Caller must ensure referenced callable object is alive when calling it.
+ */
+template <typename Result, typename ... Args>
+class FunctionRef<Result(Args...)>
+{
+public:
+	/**
+	 * Creates empty reference.
+	 */
+	FunctionRef() noexcept;
+
+	/**
+	 * Creates empty reference.
+	 */
+	FunctionRef(std::nullptr_t) noexcept;
+
+	/**
+	 * Creates reference of @c std::function. It's empty if @c function is empty.
+	 */
+	FunctionRef(const std::function<Result(Args...)>& function) noexcept;
+
+	/**
+	 * Creates reference of callable object.
+	 */
+	template <typename Callable,
+			  typename = std::enable_if_t<
+				  !std::is_same_v<std::decay_t<Callable>, FunctionRef> &&
+				  !std::is_same_v<std::decay_t<Callable>, std::function<Result(Args...)>> &&
+				  std::is_invocable_r_v<Result, Callable&, Args...>>>
+	FunctionRef(Callable&& callable) noexcept;
+
+	/**
+	 * Calls referenced callable object.
+	 * @throw Throws std::bad_function_call if reference is empty.
+	 */
+	Result operator()(Args ... args) const;
+
+	/**
+	 * Checks reference is not empty.
+	 */
+	explicit operator bool() const noexcept;
+
+private:
+	using Callback = Result (*)(void* object, Args ... args);
+
+	template <typename Callable>
+	static Result invoke(void* object, Args ... args);
+
+	void* m_object;
+	Callback m_callback;
+};
+
+
+// ================================= Inline implement. =================================
+
+template <typename Result, typename ... Args>
+inline FunctionRef<Result(Args...)>::FunctionRef() noexcept :
+	m_object(nullptr),
+	m_callback(nullptr)
+{}
+
+
+template <typename Result, typename ... Args>
+inline FunctionRef<Result(Args...)>::FunctionRef(std::nullptr_t) noexcept :
+	m_object(nullptr),
+	m_callback(nullptr)
+{}
+
+
+template <typename Result, typename ... Args>
+inline FunctionRef<Result(Args...)>::FunctionRef(const std::function<Result(Args...)>& function) noexcept :
+	m_object(function ? const_cast<void*>(static_cast<const void*>(&function)) : nullptr),
+	m_callback(function ? &invoke<const std::function<Result(Args...)>> : nullptr)
+{}
+
+
+template <typename Result, typename ... Args>
+template <typename Callable, typename>
+inline FunctionRef<Result(Args...)>::FunctionRef(Callable&& callable) noexcept :
+	m_object(const_cast<void*>(static_cast<const void*>(std::addressof(callable)))),
+	m_callback(&invoke<std::remove_reference_t<Callable>>)
+{}
+
+
+template <typename Result, typename ... Args>
+inline Result FunctionRef<Result(Args...)>::operator()(Args ... args) const
+{
+	if (m_callback == nullptr)
+	{
+		throw std::bad_function_call();
+	}
+	return m_callback(m_object, std::forward<Args>(args)...);
+}
+
+
+template <typename Result, typename ... Args>
+inline FunctionRef<Result(Args...)>::operator bool() const noexcept
+{
+	return m_callback != nullptr;
+}
+
+
+template <typename Result, typename ... Args>
+template <typename Callable>
+inline Result FunctionRef<Result(Args...)>::invoke(void* object, Args ... args)
+{
+	return (*static_cast<Callable*>(object))(std::forward<Args>(args)...);
+}
+
+} // namespace spaceless
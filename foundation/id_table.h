@@ -0,0 +1,231 @@
+/**
+ * id_table.h
+ * @author wherewindblow
+ * @date   Mar 22, 2019
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <utility>
+
+
+namespace spaceless {
+
+/**
+ * Flat table that maps id to value. Id is used as index of slot directly and uses linear probing when
+ * slot is occupied, so sequential id that is alive at the same time almost never probes.
+ * @note Id cannot be zero, because zero is used to mark empty slot.
+ */
+template <typename T>
+class IdTable
+{
+public:
+	/**
+	 * Creates table.
+	 */
+	IdTable(std::size_t init_capacity = 64);
+
+	/**
+	 * Inserts value.
+	 * @return Returns false if id already exist.
+	 */
+	bool insert(int id, T value);
+
+	/**
+	 * Removes value.
+	 * @return Returns false if cannot find id.
+	 */
+	bool remove(int id);
+
+	/**
+	 * Finds value.
+	 * @note Returns nullptr if cannot find id.
+	 */
+	T* find(int id);
+
+	/**
+	 * Returns number of value.
+	 */
+	std::size_t size() const;
+
+	/**
+	 * Returns number of slot.
+	 */
+	std::size_t capacity() const;
+
+private:
+	static const int EMPTY_ID = 0;
+
+	struct Slot
+	{
+		int id;
+		T value;
+	};
+
+	std::size_t index_of(int id) const;
+
+	/**
+	 * Returns index of slot that hold id. Returns capacity if cannot find id.
+	 */
+	std::size_t find_index(int id) const;
+
+	void grow();
+
+	std::vector<Slot> m_slot_list;
+	std::size_t m_mask;
+	std::size_t m_size;
+};
+
+
+// ================================= Inline implement. =================================
+
+template <typename T>
+IdTable<T>::IdTable(std::size_t init_capacity) :
+	m_slot_list(),
+	m_mask(0),
+	m_size(0)
+{
+	std::size_t capacity = 1;
+	while (capacity < init_capacity)
+	{
+		capacity <<= 1;
+	}
+	m_slot_list.resize(capacity, Slot{EMPTY_ID, T()});
+	m_mask = capacity - 1;
+}
+
+
+template <typename T>
+bool IdTable<T>::insert(int id, T value)
+{
+	if (find_index(id) != m_slot_list.size())
+	{
+		return false;
+	}
+
+	// Keeps load factor under half to keep probing short.
+	if ((m_size + 1) * 2 > m_slot_list.size())
+	{
+		grow();
+	}
+
+	std::size_t index = index_of(id);
+	while (m_slot_list[index].id != EMPTY_ID)
+	{
+		index = (index + 1) & m_mask;
+	}
+	m_slot_list[index].id = id;
+	m_slot_list[index].value = std::move(value);
+	++m_size;
+	return true;
+}
+
+
+template <typename T>
+bool IdTable<T>::remove(int id)
+{
+	std::size_t index = find_index(id);
+	if (index == m_slot_list.size())
+	{
+		return false;
+	}
+
+	// Shifts back following slot to fill the hole, so finding never need tombstone.
+	std::size_t hole = index;
+	std::size_t next = (hole + 1) & m_mask;
+	while (m_slot_list[next].id != EMPTY_ID)
+	{
+		std::size_t home = index_of(m_slot_list[next].id);
+		// Slot can move to hole if its home is not in range of (hole, next].
+		if (((next - home) & m_mask) >= ((next - hole) & m_mask))
+		{
+			m_slot_list[hole] = std::move(m_slot_list[next]);
+			hole = next;
+		}
+		next = (next + 1) & m_mask;
+	}
+	m_slot_list[hole].id = EMPTY_ID;
+	m_slot_list[hole].value = T();
+	--m_size;
+	return true;
+}
+
+
+template <typename T>
+T* IdTable<T>::find(int id)
+{
+	std::size_t index = find_index(id);
+	if (index == m_slot_list.size())
+	{
+		return nullptr;
+	}
+	return &m_slot_list[index].value;
+}
+
+
+template <typename T>
+std::size_t IdTable<T>::size() const
+{
+	return m_size;
+}
+
+
+template <typename T>
+std::size_t IdTable<T>::capacity() const
+{
+	return m_slot_list.size();
+}
+
+
+template <typename T>
+std::size_t IdTable<T>::index_of(int id) const
+{
+	return static_cast<std::size_t>(static_cast<unsigned>(id)) & m_mask;
+}
+
+
+template <typename T>
+std::size_t IdTable<T>::find_index(int id) const
+{
+	if (id == EMPTY_ID)
+	{
+		return m_slot_list.size();
+	}
+
+	std::size_t index = index_of(id);
+	while (m_slot_list[index].id != EMPTY_ID)
+	{
+		if (m_slot_list[index].id == id)
+		{
+			return index;
+		}
+		index = (index + 1) & m_mask;
+	}
+	return m_slot_list.size();
+}
+
+
+template <typename T>
+void IdTable<T>::grow()
+{
+	std::vector<Slot> old_list(m_slot_list.size() * 2, Slot{EMPTY_ID, T()});
+	old_list.swap(m_slot_list);
+	m_mask = m_slot_list.size() - 1;
+
+	for (Slot& slot : old_list)
+	{
+		if (slot.id != EMPTY_ID)
+		{
+			std::size_t index = index_of(slot.id);
+			while (m_slot_list[index].id != EMPTY_ID)
+			{
+				index = (index + 1) & m_mask;
+			}
+			m_slot_list[index] = std::move(slot);
+		}
+	}
+}
+
+} // namespace spaceless
@@ -0,0 +1,67 @@
+/**
+ * latency_histogram.cpp
+ * @author wherewindblow
+ * @date   Mar 24, 2019
+ */
+
+#include "latency_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+
+namespace spaceless {
+
+LatencyHistogram::LatencyHistogram()
+{
+	reset();
+}
+
+
+std::int64_t LatencyHistogram::percentile(double percent) const
+{
+	if (m_count == 0)
+	{
+		return 0;
+	}
+
+	percent = std::max(0.0, std::min(percent, 100.0));
+	auto target = static_cast<std::uint64_t>(std::ceil(percent / 100.0 * static_cast<double>(m_count)));
+	target = std::max(target, std::uint64_t(1));
+
+	std::uint64_t accumulation = 0;
+	for (int i = 0; i < BUCKET_NUM; ++i)
+	{
+		accumulation += m_bucket_list[i];
+		if (accumulation >= target)
+		{
+			// Value in bucket is not larger than recorded max value.
+			return std::min(bucket_max_value(i), m_max);
+		}
+	}
+	return m_max;
+}
+
+
+void LatencyHistogram::reset()
+{
+	std::fill(std::begin(m_bucket_list), std::end(m_bucket_list), 0);
+	m_count = 0;
+	m_max = 0;
+}
+
+
+std::int64_t LatencyHistogram::bucket_max_value(int index)
+{
+	if (index < SUB_BUCKET_NUM)
+	{
+		return index;
+	}
+
+	int shift = index / HALF_SUB_BUCKET_NUM - 1;
+	int sub_index = index - shift * HALF_SUB_BUCKET_NUM;
+	return ((static_cast<std::int64_t>(sub_index) + 1) << shift) - 1;
+}
+
+} // namespace spaceless
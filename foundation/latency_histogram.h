@@ -0,0 +1,129 @@
+/**
+ * latency_histogram.h
+ * @author wherewindblow
+ * @date   Mar 24, 2019
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace spaceless {
+
+/**
+ * Histogram of latency in microsecond. Bucket is log-linear like HDR histogram: value that less than
+ * @c SUB_BUCKET_NUM has its own bucket, and each power of two range is divided into @c SUB_BUCKET_NUM / 2
+ * linear buckets, so relative error of percentile is less than 1 / (SUB_BUCKET_NUM / 2). Recording is
+ * only a few bit operations and never allocates memory.
+ * @note It's not thread safe. Uses one histogram in each thread.
+ */
+class LatencyHistogram
+{
+public:
+	/**
+	 * Creates empty histogram.
+	 */
+	LatencyHistogram();
+
+	/**
+	 * Records latency. Negative latency is recorded as zero and latency that larger than max trackable
+	 * latency is recorded as max trackable latency.
+	 */
+	void record(std::int64_t latency_us);
+
+	/**
+	 * Returns the latency that @c percent of recorded latency are not larger than it.
+	 * Returns zero if have no recorded latency.
+	 */
+	std::int64_t percentile(double percent) const;
+
+	/**
+	 * Returns max recorded latency.
+	 */
+	std::int64_t max() const;
+
+	/**
+	 * Returns number of recorded latency.
+	 */
+	std::uint64_t count() const;
+
+	/**
+	 * Clears all recorded latency.
+	 */
+	void reset();
+
+private:
+	static const int SUB_BUCKET_BITS = 5;
+	static const int SUB_BUCKET_NUM = 1 << SUB_BUCKET_BITS;
+	static const int HALF_SUB_BUCKET_NUM = SUB_BUCKET_NUM / 2;
+	static const int MAX_VALUE_BITS = 32; // About 71 minutes.
+	static const std::int64_t MAX_TRACKABLE_VALUE = (std::int64_t(1) << MAX_VALUE_BITS) - 1;
+	static const int BUCKET_NUM = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * HALF_SUB_BUCKET_NUM + HALF_SUB_BUCKET_NUM;
+
+	/**
+	 * Returns index of bucket that value belong to.
+	 */
+	static int bucket_index(std::uint64_t value);
+
+	/**
+	 * Returns the largest value that belong to bucket.
+	 */
+	static std::int64_t bucket_max_value(int index);
+
+	std::uint32_t m_bucket_list[BUCKET_NUM];
+	std::uint64_t m_count;
+	std::int64_t m_max;
+};
+
+
+// ================================= Inline implement. =================================
+
+inline void LatencyHistogram::record(std::int64_t latency_us)
+{
+	if (latency_us < 0)
+	{
+		latency_us = 0;
+	}
+	else if (latency_us > MAX_TRACKABLE_VALUE)
+	{
+		latency_us = MAX_TRACKABLE_VALUE;
+	}
+
+	++m_bucket_list[bucket_index(static_cast<std::uint64_t>(latency_us))];
+	++m_count;
+	if (latency_us > m_max)
+	{
+		m_max = latency_us;
+	}
+}
+
+
+inline std::int64_t LatencyHistogram::max() const
+{
+	return m_max;
+}
+
+
+inline std::uint64_t LatencyHistogram::count() const
+{
+	return m_count;
+}
+
+
+inline int LatencyHistogram::bucket_index(std::uint64_t value)
+{
+	if (value < static_cast<std::uint64_t>(SUB_BUCKET_NUM))
+	{
+		return static_cast<int>(value);
+	}
+
+	// Keeps the highest SUB_BUCKET_BITS bits of value, that is in range of [HALF_SUB_BUCKET_NUM, SUB_BUCKET_NUM).
+	int highest_bit = 63 - __builtin_clzll(value);
+	int shift = highest_bit - SUB_BUCKET_BITS + 1;
+	auto sub_index = static_cast<int>(value >> shift);
+	return shift * HALF_SUB_BUCKET_NUM + sub_index;
+}
+
+} // namespace spaceless
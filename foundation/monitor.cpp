@@ -7,6 +7,8 @@
 
 #include "monitor.h"
 
+#include <protocol/command.h>
+
 #include "exception.h"
 #include "worker.h"
 #include "log.h"
@@ -16,14 +18,19 @@ namespace spaceless {
 
 static Logger& logger = get_logger("monitor");
 
-MonitorManager::MonitorManager()
+MonitorManager::MonitorManager() :
+	m_monitor_list(),
+	m_latency_list(),
+	m_latency_table()
 {
-	TimerManager::instance()->register_frequent_timer("MonitorManager", lights::PreciseTime(MONITOR_STATE_PER_SEC), [&]
+	int worker_index = WorkerScheduler::instance()->current_worker_index();
+	TimerManager::instance()->register_frequent_timer("MonitorManager", lights::PreciseTime(MONITOR_STATE_PER_SEC), [&, worker_index]
 	{
 		for (auto& pair : m_monitor_list)
 		{
-			LIGHTS_INFO(logger, "Manager={}, size={}.", pair.first, pair.second());
+			LIGHTS_INFO(logger, "Worker={}, Manager={}, size={}.", worker_index, pair.first, pair.second());
 		}
+		report_latency(worker_index);
 	});
 }
 
@@ -44,5 +51,57 @@ void MonitorManager::remove_monitor(const std::string& name)
 	m_monitor_list.erase(name);
 }
 
+
+void MonitorManager::record_latency(int cmd, LatencyType type, std::int64_t latency_us)
+{
+	CommandLatency** latency = m_latency_table.find(cmd);
+	if (latency == nullptr)
+	{
+		// Command is sent by remote, so only known command is recorded to keep memory bounded.
+		if (cmd == 0 || protocol::find_message_name(cmd) == nullptr)
+		{
+			return;
+		}
+
+		m_latency_list.emplace_back(new CommandLatency());
+		m_latency_list.back()->cmd = cmd;
+		m_latency_table.insert(cmd, m_latency_list.back().get());
+		latency = m_latency_table.find(cmd);
+	}
+	(*latency)->histogram_list[type].record(latency_us);
+}
+
+
+void MonitorManager::report_latency(int worker_index)
+{
+	static const char* TYPE_NAME_LIST[LATENCY_TYPE_NUM] = {"queue", "handle", "end_to_end"};
+
+	for (auto& latency : m_latency_list)
+	{
+		const std::string* name = protocol::find_message_name(latency->cmd);
+		for (int type = 0; type < LATENCY_TYPE_NUM; ++type)
+		{
+			LatencyHistogram& histogram = latency->histogram_list[type];
+			if (histogram.count() == 0)
+			{
+				continue;
+			}
+
+			LIGHTS_INFO(logger, "Worker={}, Command={}, name={}, latency={}, count={}, "
+				"p50_us={}, p90_us={}, p99_us={}, max_us={}.",
+						worker_index,
+						latency->cmd,
+						name != nullptr ? *name : "",
+						TYPE_NAME_LIST[type],
+						histogram.count(),
+						histogram.percentile(50),
+						histogram.percentile(90),
+						histogram.percentile(99),
+						histogram.max());
+			histogram.reset();
+		}
+	}
+}
+
 } // namespace spaceless
 
@@ -6,25 +6,47 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <functional>
 #include <map>
+#include <memory>
+#include <vector>
 
 #include "basics.h"
+#include "id_table.h"
+#include "latency_histogram.h"
 
 
 namespace spaceless {
 
 /**
- * Monitor state.
+ * Monitor state and latency of each command.
+ * @note Each worker has its own monitor manager that monitors state of that worker.
  */
 class MonitorManager
 {
 public:
-	SPACELESS_SINGLETON_INSTANCE(MonitorManager);
+	/**
+	 * Returns monitor manager of current worker.
+	 * @throw Throws exception if current thread is not a worker. Network and compute thread must delegate
+	 *        to worker by @c Delegation.
+	 */
+	static MonitorManager* instance();
 
 	using GetSizeFunction = std::function<std::size_t()>;
 
+	/**
+	 * Type of command latency.
+	 */
+	enum LatencyType
+	{
+		QUEUE_LATENCY, // From network thread pushes package to worker pops it.
+		HANDLE_LATENCY, // Execution of transaction handler.
+		END_TO_END_LATENCY, // From multiply phase transaction start to end.
+		LATENCY_TYPE_NUM,
+	};
+
 	/**
 	 * Creates monitor manager.
 	 */
@@ -41,8 +63,28 @@ public:
 	 */
 	void remove_monitor(const std::string& name);
 
+	/**
+	 * Records latency of command. Percentile of latency is reported with monitor state and then reset.
+	 * @note Latency of unknown command is ignored.
+	 */
+	void record_latency(int cmd, LatencyType type, std::int64_t latency_us);
+
 private:
+	struct CommandLatency
+	{
+		int cmd;
+		LatencyHistogram histogram_list[LATENCY_TYPE_NUM];
+	};
+
+	/**
+	 * Logs percentile of latency of each command and resets it.
+	 */
+	void report_latency(int worker_index);
+
 	std::map<std::string, GetSizeFunction> m_monitor_list;
+	std::vector<std::unique_ptr<CommandLatency>> m_latency_list;
+	// Command to latency. Latency is found in each message, so uses flat table.
+	IdTable<CommandLatency*> m_latency_table;
 };
 
 
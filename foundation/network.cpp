@@ -105,6 +105,18 @@ void NetworkManager::stop()
 }
 
 
+bool NetworkManager::is_network_thread() const
+{
+	return p_impl->is_network_thread();
+}
+
+
+void NetworkManager::push_to_worker(const ActorMessage& msg, CommandPriority priority, std::size_t worker_index)
+{
+	p_impl->push_to_worker(msg, priority, worker_index);
+}
+
+
 NetworkService& NetworkServiceManager::register_service(const std::string& ip, unsigned short port)
 {
 	NetworkService* old_service = find_service(ip, port);
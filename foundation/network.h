@@ -12,6 +12,7 @@
 
 #include "basics.h"
 #include "package.h"
+#include "actor_message.h"
 
 
 /**
@@ -125,6 +126,18 @@ public:
 	 */
 	void stop();
 
+	/**
+	 * Checks current thread is network thread.
+	 */
+	bool is_network_thread() const;
+
+	/**
+	 * Pushes message to worker without waiting. If input queue of worker is full, message is kept in order
+	 * and pushed later by network thread.
+	 * @note Only use in network thread.
+	 */
+	void push_to_worker(const ActorMessage& msg, CommandPriority priority, std::size_t worker_index);
+
 private:
 	details::NetworkManagerImpl* p_impl;
 };
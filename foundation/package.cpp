@@ -7,6 +7,7 @@
 #include "package.h"
 
 #include <string>
+#include <algorithm>
 #include <protocol/message.h>
 #include <crypto/aes.h>
 
@@ -48,9 +49,112 @@ bool PackageBuffer::expect_content_length(std::size_t content_length)
 }
 
 
+std::vector<lights::Sequence> Package::content_list()
+{
+	if (!is_stream())
+	{
+		return {content()};
+	}
+
+	std::vector<lights::Sequence> content_list;
+	auto left_len = static_cast<std::size_t>(header().base.content_length);
+	std::size_t head_len = std::min(m_entry->length - HEADER_LEN, left_len);
+	if (head_len != 0)
+	{
+		content_list.emplace_back(m_entry->data + HEADER_LEN, head_len);
+		left_len -= head_len;
+	}
+
+	for (std::size_t i = 0; i < segment_count() && left_len != 0; ++i)
+	{
+		lights::Sequence segment_buffer = segment(i);
+		std::size_t len = std::min(segment_buffer.length(), left_len);
+		content_list.emplace_back(segment_buffer.data(), len);
+		left_len -= len;
+	}
+	return content_list;
+}
+
+
+std::vector<lights::SequenceView> Package::content_list() const
+{
+	if (!is_stream())
+	{
+		return {content()};
+	}
+
+	std::vector<lights::SequenceView> content_list;
+	auto left_len = static_cast<std::size_t>(header().base.content_length);
+	std::size_t head_len = std::min(m_entry->length - HEADER_LEN, left_len);
+	if (head_len != 0)
+	{
+		content_list.emplace_back(m_entry->data + HEADER_LEN, head_len);
+		left_len -= head_len;
+	}
+
+	for (std::size_t i = 0; i < segment_count() && left_len != 0; ++i)
+	{
+		lights::SequenceView segment_buffer = segment(i);
+		std::size_t len = std::min(segment_buffer.length(), left_len);
+		content_list.emplace_back(segment_buffer.data(), len);
+		left_len -= len;
+	}
+	return content_list;
+}
+
+
+bool Package::has_external_segment() const
+{
+	return std::any_of(m_entry->segment_list.begin(), m_entry->segment_list.end(), [](const Segment& segment)
+	{
+		return segment.is_external;
+	});
+}
+
+
+void Package::append_segment(lights::Sequence buffer, SegmentReleaser releaser)
+{
+	m_entry->segment_list.emplace_back(buffer, std::move(releaser), true);
+	header().base.content_length += static_cast<int>(buffer.length());
+}
+
+
+std::vector<lights::SequenceView> Package::buffer_list() const
+{
+	std::size_t left_len = valid_length();
+	if (!is_stream())
+	{
+		return {{m_entry->data, left_len}};
+	}
+
+	std::vector<lights::SequenceView> buffer_list;
+	std::size_t head_len = std::min(m_entry->length, left_len);
+	buffer_list.emplace_back(m_entry->data, head_len);
+	left_len -= head_len;
+
+	for (std::size_t i = 0; i < segment_count() && left_len != 0; ++i)
+	{
+		lights::SequenceView segment_buffer = segment(i);
+		std::size_t len = std::min(segment_buffer.length(), left_len);
+		buffer_list.emplace_back(segment_buffer.data(), len);
+		left_len -= len;
+	}
+	return buffer_list;
+}
+
+
 void Package::parse_to_protocol(protocol::Message& msg) const
 {
-	bool ok = protocol::parse_to_message(content(), msg);
+	bool ok;
+	if (is_stream())
+	{
+		ok = protocol::parse_to_message(content_list(), msg);
+	}
+	else
+	{
+		ok = protocol::parse_to_message(content(), msg);
+	}
+
 	if (!ok)
 	{
 		SPACELESS_THROW(ERR_NETWORK_PACKAGE_CANNOT_PARSE_TO_PROTOCOL);
@@ -58,31 +162,169 @@ void Package::parse_to_protocol(protocol::Message& msg) const
 }
 
 
-Package PackageManager::register_package(int content_len)
+Package PackageManager::register_package(int content_len, int owner_id)
 {
 	std::lock_guard<std::mutex> lock(m_mutex);
 
+	// Budget is checked by receiving connection before receive content, so registration never fails because of it.
+	std::size_t memory_size = get_memory_size(content_len);
+
 	// To support crypto in-place operation.
-	std::size_t cipher_content_len = crypto::aes_cipher_length(static_cast<size_t>(content_len));
+	std::size_t cipher_content_len = crypto::aes_gcm_cipher_length(static_cast<size_t>(content_len));
 	
 	std::size_t len = Package::HEADER_LEN + cipher_content_len;
 	char* data = new char[len];
-	Package::Entry entry(m_next_id, len, data);
-	auto value = std::make_pair(m_next_id, entry);
+	Package::Entry entry(m_next_id, len, data, owner_id);
+	entry.memory_size = memory_size;
+	return insert_entry(entry);
+}
+
+
+Package PackageManager::register_stream_package(int content_len, int owner_id)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	std::size_t memory_size = get_memory_size(content_len);
+
+	// To support crypto in-place operation.
+	std::size_t cipher_content_len = crypto::aes_gcm_cipher_length(static_cast<size_t>(content_len));
+
+	Package::Entry entry(m_next_id, Package::HEADER_LEN, new char[Package::HEADER_LEN], owner_id);
+	entry.memory_size = memory_size;
+	for (std::size_t offset = 0; offset < cipher_content_len; offset += Package::STREAM_CHUNK_LEN)
+	{
+		std::size_t chunk_len = std::min(Package::STREAM_CHUNK_LEN, cipher_content_len - offset);
+		entry.segment_list.emplace_back(lights::Sequence(new char[chunk_len], chunk_len));
+	}
+
+	// Empty content also need a segment to indicate it's stream package.
+	if (entry.segment_list.empty())
+	{
+		entry.segment_list.emplace_back(lights::Sequence(new char[crypto::AES_BLOCK_SIZE], 0));
+	}
+
+	return insert_entry(entry);
+}
+
+
+Package PackageManager::register_segment_package(int head_content_len)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	// External segment is not count in budget.
+	std::size_t memory_size = get_memory_size(head_content_len);
+
+	// Reserves cipher length to support in-place crypto when no segment is appended.
+	std::size_t cipher_content_len = crypto::aes_gcm_cipher_length(static_cast<size_t>(head_content_len));
+
+	std::size_t len = Package::HEADER_LEN + static_cast<std::size_t>(head_content_len);
+	Package::Entry entry(m_next_id, len, new char[Package::HEADER_LEN + cipher_content_len]);
+	entry.memory_size = memory_size;
+	Package package = insert_entry(entry);
+	package.header().base.content_length = head_content_len;
+	return package;
+}
+
+
+Package PackageManager::copy_package(Package package)
+{
+	int content_len = package.header().base.content_length;
+	Package new_package;
+	if (package.is_stream())
+	{
+		// Source may have head content and external segment, so copy content continuously to fixed chunk.
+		new_package = register_stream_package(content_len);
+		std::size_t offset = 0;
+		for (lights::SequenceView content : static_cast<const Package&>(package).content_list())
+		{
+			std::size_t content_offset = 0;
+			while (content_offset < content.length())
+			{
+				lights::Sequence chunk = new_package.segment(offset / Package::STREAM_CHUNK_LEN);
+				std::size_t chunk_offset = offset % Package::STREAM_CHUNK_LEN;
+				std::size_t len = std::min(chunk.length() - chunk_offset, content.length() - content_offset);
+				lights::copy_array(static_cast<char*>(chunk.data()) + chunk_offset,
+								   static_cast<const char*>(content.data()) + content_offset,
+								   len);
+				offset += len;
+				content_offset += len;
+			}
+		}
+	}
+	else
+	{
+		new_package = register_package(content_len);
+		lights::copy_array(static_cast<char*>(new_package.content_buffer().data()),
+						   static_cast<const char*>(package.content().data()),
+						   static_cast<std::size_t>(content_len));
+	}
+
+	new_package.header() = package.header();
+	return new_package;
+}
+
+
+Package PackageManager::insert_entry(const Package::Entry& entry)
+{
+	auto value = std::make_pair(entry.id, entry);
 	++m_next_id;
 
 	auto result = m_package_list.insert(value);
 	if (!result.second)
 	{
+		Package::Entry failure_entry = entry;
+		free_entry(failure_entry);
 		SPACELESS_THROW(ERR_NETWORK_PACKAGE_ALREADY_EXIST);
 	}
 
+	m_memory_size += entry.memory_size;
+	if (entry.owner_id != 0)
+	{
+		m_owner_memory_list[entry.owner_id] += entry.memory_size;
+	}
+
 	Package package(&result.first->second);
 	package.header().reset();
 	return package;
 }
 
 
+void PackageManager::erase_entry(PackageList::iterator itr)
+{
+	Package::Entry& entry = itr->second;
+	m_memory_size -= entry.memory_size;
+	if (entry.owner_id != 0)
+	{
+		auto owner_itr = m_owner_memory_list.find(entry.owner_id);
+		owner_itr->second -= entry.memory_size;
+		if (owner_itr->second == 0)
+		{
+			m_owner_memory_list.erase(owner_itr);
+		}
+	}
+
+	free_entry(entry);
+	m_package_list.erase(itr);
+}
+
+
+void PackageManager::free_entry(Package::Entry& entry)
+{
+	delete[] entry.data;
+	for (auto& segment : entry.segment_list)
+	{
+		if (!segment.is_external)
+		{
+			delete[] static_cast<char*>(segment.buffer.data());
+		}
+		else if (segment.releaser)
+		{
+			segment.releaser(segment.buffer);
+		}
+	}
+}
+
+
 void PackageManager::remove_package(int package_id)
 {
 	std::lock_guard<std::mutex> lock(m_mutex);
@@ -90,9 +332,54 @@ void PackageManager::remove_package(int package_id)
 	auto itr = m_package_list.find(package_id);
 	if (itr != m_package_list.end())
 	{
-		delete[] itr->second.data;
-		m_package_list.erase(itr);
+		erase_entry(itr);
+	}
+}
+
+
+void PackageManager::retain_package(int package_id, int count)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	auto itr = m_package_list.find(package_id);
+	if (itr == m_package_list.end())
+	{
+		SPACELESS_THROW(ERR_NETWORK_PACKAGE_NOT_EXIST);
+	}
+
+	itr->second.ref_count += count;
+}
+
+
+void PackageManager::release_package(int package_id)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	auto itr = m_package_list.find(package_id);
+	if (itr == m_package_list.end())
+	{
+		return;
+	}
+
+	--itr->second.ref_count;
+	if (itr->second.ref_count <= 0)
+	{
+		erase_entry(itr);
+	}
+}
+
+
+bool PackageManager::is_shared_package(int package_id)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	auto itr = m_package_list.find(package_id);
+	if (itr == m_package_list.end())
+	{
+		return false;
 	}
+
+	return itr->second.ref_count > 1;
 }
 
 
@@ -122,6 +409,67 @@ Package PackageManager::get_package(int package_id)
 }
 
 
+void PackageManager::set_memory_budget(std::size_t total_budget, std::size_t owner_budget)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_total_budget = total_budget;
+	m_owner_budget = owner_budget;
+}
+
+
+bool PackageManager::has_memory_budget(int content_len, int owner_id)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return has_memory_budget_without_lock(get_memory_size(content_len), owner_id);
+}
+
+
+std::size_t PackageManager::memory_size()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_memory_size;
+}
+
+
+std::size_t PackageManager::memory_budget_usage()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_total_budget == 0)
+	{
+		return 0;
+	}
+	return m_memory_size * 100 / m_total_budget;
+}
+
+
+std::size_t PackageManager::get_memory_size(int content_len)
+{
+	return Package::HEADER_LEN + crypto::aes_gcm_cipher_length(static_cast<size_t>(content_len));
+}
+
+
+bool PackageManager::has_memory_budget_without_lock(std::size_t memory_size, int owner_id) const
+{
+	// Always allows first package, so package that larger than budget will not be blocked forever.
+	if (m_total_budget != 0 && m_memory_size != 0 && m_memory_size + memory_size > m_total_budget)
+	{
+		return false;
+	}
+
+	if (m_owner_budget != 0 && owner_id != 0)
+	{
+		auto itr = m_owner_memory_list.find(owner_id);
+		std::size_t owner_memory_size = (itr == m_owner_memory_list.end()) ? 0 : itr->second;
+		if (owner_memory_size != 0 && owner_memory_size + memory_size > m_owner_budget)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
 std::size_t PackageManager::size()
 {
 	std::lock_guard<std::mutex> lock(m_mutex);
@@ -7,7 +7,11 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <map>
+#include <vector>
+#include <functional>
+#include <utility>
 #include <mutex>
 
 #include <lights/env.h>
@@ -51,6 +55,9 @@ struct PackageHeader
 		int self_package_id;
 		// self_package_id of request.
 		int trigger_package_id;
+		// Remaining time of request in millisecond. Request that is not dispatched within it is dropped.
+		// Zero means request have no deadline. It's relative time, so it's not affected by clock of peer.
+		int time_budget_ms;
 	} LIGHTS_NOT_MEMORY_ALIGNMENT;
 
 
@@ -192,27 +199,70 @@ private:
 /**
  * Network package include header and content. It's use to optimize package memory using.
  * It's light object, so can pass by value.
+ * Stream package keeps content in segment list instead of contiguous buffer. So it can hold content
+ * that larger than @c PackageBuffer::MAX_CONTENT_LEN and can be sent and received incrementally.
+ * Segment can also reference to external memory (such as mapped file region), and then content will
+ * be sent by gather write without copying into package.
  */
 class Package
 {
 public:
 	static const std::size_t HEADER_LEN = sizeof(PackageHeader);
+	// Each chunk is this length except the last one, so content can be located by offset.
+	static const std::size_t STREAM_CHUNK_LEN = 65536;
+	static const std::size_t MAX_STREAM_CONTENT_LEN = 16 * 1024 * 1024;
 
 	using LengthCalculator = std::size_t (*)(std::size_t);
 
+	/**
+	 * Releases external memory of segment.
+	 * @note It's call when package is destroyed and may be call in any thread. Cannot use PackageManager in it.
+	 */
+	using SegmentReleaser = std::function<void(lights::Sequence buffer)>;
+
+	struct Segment
+	{
+		Segment(lights::Sequence buffer, SegmentReleaser releaser = nullptr, bool is_external = false):
+			buffer(buffer),
+			releaser(std::move(releaser)),
+			is_external(is_external)
+		{}
+
+		lights::Sequence buffer;
+		// Releases external memory. Memory of internal segment is always release by package.
+		SegmentReleaser releaser;
+		// External segment is not own by package and its length is not limited.
+		bool is_external;
+	};
+
 	struct Entry
 	{
-		Entry(int id, std::size_t length, char* data):
+		Entry(int id, std::size_t length, char* data, int owner_id = 0):
 			id(id),
 			length(length),
 			data(data),
-			length_calculator()
+			length_calculator(),
+			ref_count(1),
+			owner_id(owner_id),
+			memory_size(0),
+			deadline_us(0)
 		{}
 
 		int id;
+		// Length of data. It's header and head content for stream package.
 		std::size_t length;
 		char* data;
 		LengthCalculator length_calculator;
+		// Number of owner that hold this package. Protected by PackageManager.
+		int ref_count;
+		// Content segments of stream package. Each internal segment is STREAM_CHUNK_LEN except the last one.
+		std::vector<Segment> segment_list;
+		// Connection that receive this package. It's zero if package is not belong to any connection.
+		int owner_id;
+		// Memory that allocate by package and count in budget. Not include external segment.
+		std::size_t memory_size;
+		// Local monotonic time in microsecond that request expire. It's zero if request have no deadline.
+		std::int64_t deadline_us;
 	};
 
 	/**
@@ -336,6 +386,71 @@ public:
 		return m_entry->length;
 	}
 
+	/**
+	 * Checks package is stream package.
+	 * @note Stream package only have header and head content in @c data and cannot use @c content
+	 *       and @c content_buffer.
+	 */
+	bool is_stream() const
+	{
+		return !m_entry->segment_list.empty();
+	}
+
+	/**
+	 * Returns number of content segment of stream package.
+	 */
+	std::size_t segment_count() const
+	{
+		return m_entry->segment_list.size();
+	}
+
+	/**
+	 * Returns all buffer of indicate segment.
+	 */
+	lights::Sequence segment(std::size_t index)
+	{
+		return m_entry->segment_list[index].buffer;
+	}
+
+	/**
+	 * Returns all buffer of indicate segment.
+	 */
+	lights::SequenceView segment(std::size_t index) const
+	{
+		return m_entry->segment_list[index].buffer;
+	}
+
+	/**
+	 * Checks package have segment that reference to external memory.
+	 * @note External segment cannot be modified, so cannot do in-place crypto on this package.
+	 */
+	bool has_external_segment() const;
+
+	/**
+	 * Appends segment that reference to external memory after current content and increase content length.
+	 * @param buffer    External memory that must keep valid until @c releaser is call.
+	 * @param releaser  Releases external memory after package is destroyed.
+	 * @note Cannot append segment after package is sending.
+	 */
+	void append_segment(lights::Sequence buffer, SegmentReleaser releaser = nullptr);
+
+	/**
+	 * Returns header and content as list according to valid length. It's use to gather write.
+	 */
+	std::vector<lights::SequenceView> buffer_list() const;
+
+	/**
+	 * Returns content as list according to header content length. Works with stream and normal package.
+	 * @note Must ensure header is valid.
+	 */
+	std::vector<lights::Sequence> content_list();
+
+	/**
+	 * Returns content as list according to header content length. Works with stream and normal package.
+	 * @note Must ensure header is valid.
+	 */
+	std::vector<lights::SequenceView> content_list() const;
+
 	/**
 	 * Parses package content as protocol message.
 	 */
@@ -349,6 +464,22 @@ public:
 		return PackageTriggerSource(header().base.command, header().extend.self_package_id);
 	}
 
+	/**
+	 * Returns local monotonic time in microsecond that request expire. Returns zero if have no deadline.
+	 */
+	std::int64_t deadline_us() const
+	{
+		return m_entry->deadline_us;
+	}
+
+	/**
+	 * Sets local monotonic time in microsecond that request expire.
+	 */
+	void set_deadline_us(std::int64_t deadline_us)
+	{
+		m_entry->deadline_us = deadline_us;
+	}
+
 private:
 	Entry* m_entry;
 };
@@ -356,6 +487,10 @@ private:
 
 /**
  * Manager of package and guarantee package are valid when connection underlying write is call.
+ * Package is reference counted. It's create with one reference and destroy when last reference is release.
+ * Package memory is limit by total budget and budget of each owner connection. Zero budget means unlimited.
+ * Budget only limits receiving. Connection checks it before receive content and stops reading socket when it's
+ * exhausted, and registration only counts memory, so sending package or local package never fails because of it.
  * All operation in this class is thread safe.
  */
 class PackageManager
@@ -365,15 +500,53 @@ public:
 
 	/**
 	 * Registers package buffer.
+	 * @param owner_id  Connection that receive this package and memory will be count in its budget.
+	 * @throw Throws exception if register failure.
+	 */
+	Package register_package(int content_len, int owner_id = 0);
+
+	/**
+	 * Registers stream package that content is store in segment list.
+	 * @param owner_id  Connection that receive this package and memory will be count in its budget.
+	 * @throw Throws exception if register failure.
+	 */
+	Package register_stream_package(int content_len, int owner_id = 0);
+
+	/**
+	 * Registers package that only have head content and can append external segment after it.
+	 * @throw Throws exception if register failure.
+	 */
+	Package register_segment_package(int head_content_len);
+
+	/**
+	 * Registers a new package that have same header and content with @c package.
 	 * @throw Throws exception if register failure.
 	 */
-	Package register_package(int content_len);
+	Package copy_package(Package package);
 
 	/**
 	 * Removes package buffer.
+	 * @note Package will be destroy immediately no matter how many reference it have.
 	 */
 	void remove_package(int package_id);
 
+	/**
+	 * Adds reference of package. Each reference must be release by @c release_package.
+	 * @throw Throws exception if cannot find package.
+	 */
+	void retain_package(int package_id, int count = 1);
+
+	/**
+	 * Releases a reference of package and destroy package when it's last reference.
+	 */
+	void release_package(int package_id);
+
+	/**
+	 * Checks package is hold by more than one owner.
+	 * @note Returns false if cannot find package.
+	 */
+	bool is_shared_package(int package_id);
+
 	/**
 	 * Finds package buffer.
 	 * @note Returns nullptr if cannot find package.
@@ -386,14 +559,68 @@ public:
 	 */
 	Package get_package(int package_id);
 
+	/**
+	 * Sets memory budget of all package and each owner. Zero budget means unlimited.
+	 */
+	void set_memory_budget(std::size_t total_budget, std::size_t owner_budget);
+
+	/**
+	 * Checks have enough budget to receive package for owner.
+	 */
+	bool has_memory_budget(int content_len, int owner_id = 0);
+
+	/**
+	 * Returns memory size of all package.
+	 */
+	std::size_t memory_size();
+
+	/**
+	 * Returns percentage of total budget that is used. Returns zero if total budget is unlimited.
+	 */
+	std::size_t memory_budget_usage();
+
 	/**
 	 * Returns number of package.
 	 */
 	std::size_t size();
 
 private:
+	/**
+	 * Returns memory size of package that register by content length.
+	 */
+	static std::size_t get_memory_size(int content_len);
+
+	/**
+	 * Checks have enough budget to allocate memory for owner.
+	 * @note Must lock before call this function.
+	 */
+	bool has_memory_budget_without_lock(std::size_t memory_size, int owner_id) const;
+
+	/**
+	 * Inserts entry to package list.
+	 * @note Must lock before call this function.
+	 */
+	Package insert_entry(const Package::Entry& entry);
+
+	/**
+	 * Frees all memory of entry.
+	 */
+	void free_entry(Package::Entry& entry);
+
+	using PackageList = std::map<int, Package::Entry>;
+
+	/**
+	 * Erases entry from package list and update memory usage.
+	 * @note Must lock before call this function.
+	 */
+	void erase_entry(PackageList::iterator itr);
+
 	int m_next_id = 1;
-	std::map<int, Package::Entry> m_package_list;
+	PackageList m_package_list;
+	std::size_t m_memory_size = 0;
+	std::size_t m_total_budget = 0;
+	std::size_t m_owner_budget = 0;
+	std::map<int, std::size_t> m_owner_memory_list;
 	std::mutex m_mutex;
 };
 
@@ -0,0 +1,273 @@
+/**
+ * ring_queue.h
+ * @author wherewindblow
+ * @date   Mar 02, 2019
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <algorithm>
+
+
+namespace spaceless {
+
+/**
+ * Bounded lock-free ring queue that support single consumer and single or multiple producer.
+ * Each cell has sequence number to indicate it's ready to write or read, so producer and consumer
+ * never wait each other by lock.
+ * @note 1. Only one thread can pop at the same time.
+ *       2. Single producer mode is only valid when one thread push at the same time. It avoids
+ *          compare and swap of tail index.
+ */
+template <typename T>
+class RingQueue
+{
+public:
+	/**
+	 * Creates ring queue.
+	 * @param capacity  Max number of element. It'll be round up to power of two.
+	 */
+	explicit RingQueue(std::size_t capacity, bool is_single_producer = false);
+
+	/**
+	 * Disable copy constructor.
+	 */
+	RingQueue(const RingQueue&) = delete;
+
+	/**
+	 * Sets producer mode.
+	 * @note Must set before any element is pushed.
+	 */
+	void set_single_producer(bool is_single_producer);
+
+	/**
+	 * Pushes element to the end of queue.
+	 * @return Returns false if queue is full.
+	 */
+	bool push(const T& value);
+
+	/**
+	 * Pushes a list of element to the end of queue and keep them continuous.
+	 * @return Returns number of element that is pushed. It's less than @c count if queue have not enough space.
+	 */
+	std::size_t push(const T* value_list, std::size_t count);
+
+	/**
+	 * Pops element from the front of queue.
+	 * @return Returns false if queue is empty.
+	 */
+	bool pop(T& value);
+
+	/**
+	 * Pops a list of element from the front of queue.
+	 * @return Returns number of element that is popped.
+	 */
+	std::size_t pop(T* value_list, std::size_t max_count);
+
+	/**
+	 * Checks queue is empty.
+	 * @note It's only a snapshot when other thread is operating queue.
+	 */
+	bool empty() const;
+
+	/**
+	 * Returns number of element.
+	 * @note It's only a snapshot when other thread is operating queue.
+	 */
+	std::size_t size() const;
+
+	/**
+	 * Returns max number of element.
+	 */
+	std::size_t capacity() const;
+
+private:
+	static const std::size_t CACHE_LINE_SIZE = 64;
+
+	struct Cell
+	{
+		std::atomic<std::size_t> sequence;
+		T value;
+	};
+
+	std::unique_ptr<Cell[]> m_cell_list;
+	std::size_t m_mask;
+	bool m_is_single_producer;
+	// Separates producer and consumer index to avoid false sharing.
+	alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_tail;
+	alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_head;
+};
+
+
+// ================================= Inline implement. =================================
+
+template <typename T>
+RingQueue<T>::RingQueue(std::size_t capacity, bool is_single_producer) :
+	m_cell_list(),
+	m_mask(0),
+	m_is_single_producer(is_single_producer),
+	m_tail(0),
+	m_head(0)
+{
+	std::size_t real_capacity = 2;
+	while (real_capacity < capacity)
+	{
+		real_capacity *= 2;
+	}
+
+	m_cell_list.reset(new Cell[real_capacity]);
+	m_mask = real_capacity - 1;
+	for (std::size_t i = 0; i < real_capacity; ++i)
+	{
+		m_cell_list[i].sequence.store(i, std::memory_order_relaxed);
+	}
+}
+
+
+template <typename T>
+void RingQueue<T>::set_single_producer(bool is_single_producer)
+{
+	m_is_single_producer = is_single_producer;
+}
+
+
+template <typename T>
+bool RingQueue<T>::push(const T& value)
+{
+	std::size_t pos = m_tail.load(std::memory_order_relaxed);
+	Cell* cell;
+	while (true)
+	{
+		cell = &m_cell_list[pos & m_mask];
+		std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+		auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+		if (diff == 0)
+		{
+			if (m_is_single_producer)
+			{
+				m_tail.store(pos + 1, std::memory_order_relaxed);
+				break;
+			}
+
+			if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (diff < 0) // Consumer have not release this cell.
+		{
+			return false;
+		}
+		else // Other producer already take this cell.
+		{
+			pos = m_tail.load(std::memory_order_relaxed);
+		}
+	}
+
+	cell->value = value;
+	cell->sequence.store(pos + 1, std::memory_order_release);
+	return true;
+}
+
+
+template <typename T>
+std::size_t RingQueue<T>::push(const T* value_list, std::size_t count)
+{
+	std::size_t pos = m_tail.load(std::memory_order_relaxed);
+	std::size_t push_count;
+	while (true)
+	{
+		// Consumer releases cell in order, so all cell before head is ready to write.
+		std::size_t head = m_head.load(std::memory_order_acquire);
+		if (head > pos) // Tail is out of date.
+		{
+			pos = m_tail.load(std::memory_order_relaxed);
+			continue;
+		}
+
+		push_count = std::min(count, capacity() - (pos - head));
+		if (push_count == 0)
+		{
+			return 0;
+		}
+
+		if (m_is_single_producer)
+		{
+			m_tail.store(pos + push_count, std::memory_order_relaxed);
+			break;
+		}
+
+		if (m_tail.compare_exchange_weak(pos, pos + push_count, std::memory_order_relaxed))
+		{
+			break;
+		}
+	}
+
+	for (std::size_t i = 0; i < push_count; ++i)
+	{
+		Cell& cell = m_cell_list[(pos + i) & m_mask];
+		cell.value = value_list[i];
+		cell.sequence.store(pos + i + 1, std::memory_order_release);
+	}
+	return push_count;
+}
+
+
+template <typename T>
+bool RingQueue<T>::pop(T& value)
+{
+	std::size_t pos = m_head.load(std::memory_order_relaxed);
+	Cell& cell = m_cell_list[pos & m_mask];
+	std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+	if (sequence != pos + 1) // Producer have not finish writing this cell.
+	{
+		return false;
+	}
+
+	value = std::move(cell.value);
+	cell.value = T(); // Releases resource that hold by element as soon as possible.
+	cell.sequence.store(pos + m_mask + 1, std::memory_order_release);
+	m_head.store(pos + 1, std::memory_order_release);
+	return true;
+}
+
+
+template <typename T>
+std::size_t RingQueue<T>::pop(T* value_list, std::size_t max_count)
+{
+	std::size_t count = 0;
+	while (count < max_count && pop(value_list[count]))
+	{
+		++count;
+	}
+	return count;
+}
+
+
+template <typename T>
+bool RingQueue<T>::empty() const
+{
+	return size() == 0;
+}
+
+
+template <typename T>
+std::size_t RingQueue<T>::size() const
+{
+	std::size_t head = m_head.load(std::memory_order_acquire);
+	std::size_t tail = m_tail.load(std::memory_order_acquire);
+	return tail > head ? tail - head : 0;
+}
+
+
+template <typename T>
+std::size_t RingQueue<T>::capacity() const
+{
+	return m_mask + 1;
+}
+
+} // namespace spaceless
@@ -0,0 +1,115 @@
+/**
+ * rsa_key_pool.cpp
+ * @author wherewindblow
+ * @date   Mar 26, 2019
+ */
+
+#include "rsa_key_pool.h"
+
+#include <utility>
+
+#include "log.h"
+#include "delegation.h"
+
+
+namespace spaceless {
+
+static Logger& logger = get_logger("rsa_key_pool");
+
+
+RsaKeyPool::RsaKeyPool() :
+	m_mutex(),
+	m_capacity(0),
+	m_key_list(),
+	m_generating_count(0),
+	m_dry_count(0)
+{}
+
+
+void RsaKeyPool::set_capacity(std::size_t capacity)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_capacity = capacity;
+	m_key_list.reserve(m_capacity);
+}
+
+
+void RsaKeyPool::start()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	LIGHTS_INFO(logger, "Starting RSA key pool. capacity={}.", m_capacity);
+	fill();
+}
+
+
+bool RsaKeyPool::take(crypto::RsaKeyPair& key_pair)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_key_list.empty())
+	{
+		if (m_capacity != 0)
+		{
+			++m_dry_count;
+			LIGHTS_DEBUG(logger, "RSA key pool is dry. generating_count={}.", m_generating_count);
+		}
+		fill();
+		return false;
+	}
+
+	key_pair = std::move(m_key_list.back());
+	m_key_list.pop_back();
+	fill();
+	return true;
+}
+
+
+std::size_t RsaKeyPool::size()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_key_list.size();
+}
+
+
+std::size_t RsaKeyPool::dry_count() const
+{
+	return m_dry_count;
+}
+
+
+void RsaKeyPool::fill()
+{
+	while (m_key_list.size() + m_generating_count < m_capacity)
+	{
+		++m_generating_count;
+		Delegation::delegate("RsaKeyPool::generate", Delegation::COMPUTE, []
+		{
+			RsaKeyPool::instance()->generate();
+		});
+	}
+}
+
+
+void RsaKeyPool::generate()
+{
+	// Generates out of lock, so taking never waits for generating.
+	crypto::RsaKeyPair key_pair;
+	try
+	{
+		key_pair = crypto::generate_rsa_key_pair();
+	}
+	catch (...)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		--m_generating_count;
+		throw;
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	--m_generating_count;
+	if (m_key_list.size() < m_capacity)
+	{
+		m_key_list.push_back(std::move(key_pair));
+	}
+}
+
+} // namespace spaceless
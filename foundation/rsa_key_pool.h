@@ -0,0 +1,83 @@
+/**
+ * rsa_key_pool.h
+ * @author wherewindblow
+ * @date   Mar 26, 2019
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include <crypto/rsa.h>
+
+#include "basics.h"
+
+
+namespace spaceless {
+
+/**
+ * Pool of pre-generated RSA key pair. Generating key pair costs milliseconds, so it's generated in compute pool
+ * and secure handshake of network thread only takes generated one.
+ * @note It's thread safe.
+ */
+class RsaKeyPool
+{
+public:
+	SPACELESS_SINGLETON_INSTANCE(RsaKeyPool);
+
+	/**
+	 * Creates pool.
+	 */
+	RsaKeyPool();
+
+	/**
+	 * Sets max number of key pair that is kept in pool. Zero means not to pre-generate key pair, that is default
+	 * for process that never accepts secure connection.
+	 * @note Must set before start.
+	 */
+	void set_capacity(std::size_t capacity);
+
+	/**
+	 * Starts to fill pool in compute pool.
+	 * @note Compute pool must be started.
+	 */
+	void start();
+
+	/**
+	 * Takes one key pair and starts to generate another one to fill pool.
+	 * @return Returns false if pool is dry.
+	 */
+	bool take(crypto::RsaKeyPair& key_pair);
+
+	/**
+	 * Returns number of key pair in pool.
+	 */
+	std::size_t size();
+
+	/**
+	 * Returns number of taking when pool is dry.
+	 */
+	std::size_t dry_count() const;
+
+private:
+	/**
+	 * Generates key pair in compute pool until pool is full. Caller must lock mutex.
+	 */
+	void fill();
+
+	/**
+	 * Generates one key pair and puts it to pool. It's run in compute pool.
+	 */
+	void generate();
+
+	std::mutex m_mutex;
+	std::size_t m_capacity;
+	std::vector<crypto::RsaKeyPair> m_key_list;
+	std::size_t m_generating_count;
+	std::atomic<std::size_t> m_dry_count;
+};
+
+} // namespace spaceless
@@ -12,6 +12,8 @@
 
 #include "worker.h"
 #include "network.h"
+#include "compute_pool.h"
+#include "rsa_key_pool.h"
 #include "log.h"
 
 
@@ -49,6 +51,8 @@ void Scheduler::start()
 	catch_signal(SIGTERM, safe_exit);
 	catch_signal(SIGUSR1, safe_exit);
 
+	ComputePool::instance()->start();
+	RsaKeyPool::instance()->start();
 	WorkerScheduler::instance()->start();
 	NetworkManager::instance()->start();
 
@@ -58,6 +62,7 @@ void Scheduler::start()
 	{
 		Poco::Thread::current()->sleep(SCHEDULER_WAITING_STOP_PERIOD_MS);
 	}
+	ComputePool::instance()->stop();
 
 	LIGHTS_INFO(logger, "Stopped scheduler.");
 }
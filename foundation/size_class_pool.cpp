@@ -0,0 +1,86 @@
+/**
+ * size_class_pool.cpp
+ * @author wherewindblow
+ * @date   Mar 22, 2019
+ */
+
+#include "size_class_pool.h"
+
+#include <new>
+
+
+namespace spaceless {
+
+SizeClassPool::SizeClassPool(std::size_t max_size, std::size_t align, std::size_t max_block) :
+	m_align(align),
+	m_max_block(max_block),
+	m_block_list_of_class(max_size / align),
+	m_stats()
+{
+}
+
+
+SizeClassPool::~SizeClassPool()
+{
+	for (auto& block_list : m_block_list_of_class)
+	{
+		for (void* block : block_list)
+		{
+			::operator delete(block);
+		}
+	}
+}
+
+
+void* SizeClassPool::allocate(std::size_t size)
+{
+	++m_stats.in_use_count;
+	std::size_t size_class = (size + m_align - 1) / m_align - 1;
+	if (size_class >= m_block_list_of_class.size())
+	{
+		++m_stats.heap_alloc_count;
+		return ::operator new(size);
+	}
+
+	auto& block_list = m_block_list_of_class[size_class];
+	if (!block_list.empty())
+	{
+		void* block = block_list.back();
+		block_list.pop_back();
+		++m_stats.reuse_count;
+		--m_stats.cached_count;
+		return block;
+	}
+
+	++m_stats.heap_alloc_count;
+	return ::operator new((size_class + 1) * m_align);
+}
+
+
+void SizeClassPool::deallocate(void* block, std::size_t size)
+{
+	--m_stats.in_use_count;
+	std::size_t size_class = (size + m_align - 1) / m_align - 1;
+	if (size_class >= m_block_list_of_class.size())
+	{
+		::operator delete(block);
+		return;
+	}
+
+	auto& block_list = m_block_list_of_class[size_class];
+	if (block_list.size() >= m_max_block)
+	{
+		::operator delete(block);
+		return;
+	}
+	block_list.push_back(block);
+	++m_stats.cached_count;
+}
+
+
+const SizeClassPool::Stats& SizeClassPool::stats() const
+{
+	return m_stats;
+}
+
+} // namespace spaceless
@@ -0,0 +1,73 @@
+/**
+ * size_class_pool.h
+ * @author wherewindblow
+ * @date   Mar 22, 2019
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+
+namespace spaceless {
+
+/**
+ * Pool of memory block that recycles block by size class. Object of the same type always uses the same size
+ * class, so each type of object is effectively pooled by itself.
+ * @note It's not thread safe. Uses one pool in each thread.
+ */
+class SizeClassPool
+{
+public:
+	/**
+	 * Statistics of pool.
+	 */
+	struct Stats
+	{
+		std::size_t heap_alloc_count = 0; // Number of block that allocated from heap.
+		std::size_t reuse_count = 0; // Number of block that reused from pool.
+		std::size_t in_use_count = 0; // Number of block that is using.
+		std::size_t cached_count = 0; // Number of block that is cached in pool.
+	};
+
+	/**
+	 * Creates pool.
+	 * @param max_size   Block that larger than it is not pooled.
+	 * @param align      Size of each size class step.
+	 * @param max_block  Max number of cached block of each size class.
+	 */
+	SizeClassPool(std::size_t max_size, std::size_t align, std::size_t max_block);
+
+	/**
+	 * Releases all cached block.
+	 */
+	~SizeClassPool();
+
+	SizeClassPool(const SizeClassPool&) = delete;
+
+	SizeClassPool& operator=(const SizeClassPool&) = delete;
+
+	/**
+	 * Gets block from pool or allocates new block.
+	 */
+	void* allocate(std::size_t size);
+
+	/**
+	 * Returns block to pool. @c size must be the same as allocation.
+	 */
+	void deallocate(void* block, std::size_t size);
+
+	/**
+	 * Returns statistics of pool.
+	 */
+	const Stats& stats() const;
+
+private:
+	std::size_t m_align;
+	std::size_t m_max_block;
+	std::vector<std::vector<void*>> m_block_list_of_class;
+	Stats m_stats;
+};
+
+} // namespace spaceless
@@ -0,0 +1,135 @@
+/**
+ * thread_placement.cpp
+ * @author wherewindblow
+ * @date   Mar 16, 2019
+ */
+
+#include "thread_placement.h"
+
+#include <cstring>
+#include <algorithm>
+#include <pthread.h>
+#include <sched.h>
+
+#include "log.h"
+
+
+namespace spaceless {
+
+static Logger& logger = get_logger("scheduler");
+
+namespace details {
+
+/**
+ * Loads list of CPU from array of configuration.
+ */
+ThreadPlacement::CpuList load_cpu_list(const Configuration& configuration, const std::string& key)
+{
+	ThreadPlacement::CpuList cpu_list;
+	for (int i = 0;; ++i)
+	{
+		try
+		{
+			cpu_list.push_back(configuration.getInt(key + "[" + std::to_string(i) + "]"));
+		}
+		catch (Poco::NotFoundException& e)
+		{
+			break;  // Into array end.
+		}
+	}
+	return cpu_list;
+}
+
+
+/**
+ * Converts CPU set to readable string.
+ */
+std::string to_string(const cpu_set_t& cpu_set)
+{
+	std::string str;
+	for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+	{
+		if (CPU_ISSET(cpu, &cpu_set))
+		{
+			if (!str.empty())
+			{
+				str += ',';
+			}
+			str += std::to_string(cpu);
+		}
+	}
+	return str;
+}
+
+} // namespace details
+
+
+void ThreadPlacement::set_cpu_list(ThreadType type, const CpuList& cpu_list)
+{
+	m_cpu_list[static_cast<int>(type)] = cpu_list;
+}
+
+
+void ThreadPlacement::set_isolated_cpu_list(const CpuList& cpu_list)
+{
+	m_isolated_cpu_list = cpu_list;
+}
+
+
+void ThreadPlacement::load(const Configuration& configuration)
+{
+	set_cpu_list(ThreadType::NETWORK, details::load_cpu_list(configuration, "cpu_affinity.network"));
+	set_cpu_list(ThreadType::WORKER, details::load_cpu_list(configuration, "cpu_affinity.worker"));
+	set_cpu_list(ThreadType::COMPUTE, details::load_cpu_list(configuration, "cpu_affinity.compute"));
+	set_isolated_cpu_list(details::load_cpu_list(configuration, "cpu_affinity.irq_isolated"));
+}
+
+
+void ThreadPlacement::apply(ThreadType type, int index, const std::string& thread_name)
+{
+	const CpuList& cpu_list = m_cpu_list[static_cast<int>(type)];
+	cpu_set_t cpu_set;
+	CPU_ZERO(&cpu_set);
+
+	if (!cpu_list.empty())
+	{
+		if (type == ThreadType::NETWORK)
+		{
+			for (int cpu : cpu_list)
+			{
+				CPU_SET(cpu, &cpu_set);
+			}
+		}
+		else
+		{
+			CPU_SET(cpu_list[static_cast<std::size_t>(index) % cpu_list.size()], &cpu_set);
+		}
+	}
+	else if (!m_isolated_cpu_list.empty())
+	{
+		// Runs on all CPU that process can use except CPU that reserved for network interrupt.
+		sched_getaffinity(0, sizeof(cpu_set), &cpu_set);
+		for (int cpu : m_isolated_cpu_list)
+		{
+			CPU_CLR(cpu, &cpu_set);
+		}
+	}
+
+	if (CPU_COUNT(&cpu_set) != 0)
+	{
+		int error = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+		if (error != 0)
+		{
+			LIGHTS_ERROR(logger, "Thread {}: Cannot set CPU affinity. cpu_list={}, error={}.",
+						 thread_name, details::to_string(cpu_set), std::strerror(error));
+		}
+	}
+
+	cpu_set_t effective_set;
+	CPU_ZERO(&effective_set);
+	pthread_getaffinity_np(pthread_self(), sizeof(effective_set), &effective_set);
+	LIGHTS_INFO(logger, "Thread {}: Placement. cpu_list={}, current_cpu={}.",
+				thread_name, details::to_string(effective_set), sched_getcpu());
+}
+
+} // namespace spaceless
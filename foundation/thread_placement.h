@@ -0,0 +1,66 @@
+/**
+ * thread_placement.h
+ * @author wherewindblow
+ * @date   Mar 16, 2019
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "basics.h"
+#include "configuration.h"
+
+
+namespace spaceless {
+
+enum class ThreadType
+{
+	NETWORK,
+	WORKER,
+	COMPUTE,
+	MAX,
+};
+
+
+/**
+ * Placement of actor thread on CPU. Pins thread to specific CPU to avoid migrating across cores and
+ * thrashing cache under load.
+ */
+class ThreadPlacement
+{
+public:
+	SPACELESS_SINGLETON_INSTANCE(ThreadPlacement);
+
+	using CpuList = std::vector<int>;
+
+	/**
+	 * Sets CPU of indicate type of thread. Network thread can run on all CPU of list. Thread of pool is pinned
+	 * to one CPU of list by its index.
+	 * @note Must set before start scheduler.
+	 */
+	void set_cpu_list(ThreadType type, const CpuList& cpu_list);
+
+	/**
+	 * Sets CPU that reserved for network interrupt. Thread that have no specific CPU will not run on these CPU.
+	 * @note Must set before start scheduler.
+	 */
+	void set_isolated_cpu_list(const CpuList& cpu_list);
+
+	/**
+	 * Loads placement from "cpu_affinity" of configuration.
+	 */
+	void load(const Configuration& configuration);
+
+	/**
+	 * Pins current thread according to its type and index, and logs effective placement.
+	 */
+	void apply(ThreadType type, int index, const std::string& thread_name);
+
+private:
+	CpuList m_cpu_list[static_cast<int>(ThreadType::MAX)];
+	CpuList m_isolated_cpu_list;
+};
+
+} // namespace spaceless
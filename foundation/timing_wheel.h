@@ -0,0 +1,450 @@
+/**
+ * timing_wheel.h
+ * @author wherewindblow
+ * @date   Mar 18, 2019
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+
+namespace spaceless {
+
+/**
+ * Hierarchical timing wheel that stores value by expiry tick. Insert and remove are O(1) and advancing
+ * one tick is amortized O(1). Each level has 256 slots, the lowest level is in unit of tick and each upper
+ * level is 256 times of lower level. Value of upper level is cascaded to lower level when lower level wraps.
+ * @note Value is located by handle. Handle includes generation of node, so stale handle never refers to
+ *       other value that reuses the same node.
+ */
+template <typename T>
+class TimingWheel
+{
+public:
+	using Handle = std::uint64_t;
+
+	static constexpr Handle INVALID_HANDLE = 0;
+
+	/**
+	 * Creates timing wheel that current tick is zero.
+	 */
+	TimingWheel();
+
+	/**
+	 * Adds value that expiry at @c expiry_tick. If expiry tick is not after current tick, it'll expiry at next tick.
+	 * @return Returns handle of value.
+	 */
+	Handle add(std::uint64_t expiry_tick, T value);
+
+	/**
+	 * Adds value of expired node to wheel again and keeps its handle.
+	 * @return Returns false if handle is invalid.
+	 */
+	bool rearm(Handle handle, std::uint64_t expiry_tick);
+
+	/**
+	 * Removes value.
+	 * @return Returns false if handle is invalid.
+	 */
+	bool remove(Handle handle);
+
+	/**
+	 * Finds value.
+	 * @note Returns nullptr if handle is invalid.
+	 */
+	T* find(Handle handle);
+
+	/**
+	 * Advances current tick to @c tick and calls @c on_expiry(handle) for each expired value.
+	 * Callback can call @c find, @c rearm, @c remove and @c add. Value that is not rearmed in callback
+	 * is removed after callback.
+	 * @return Returns number of expired value.
+	 */
+	template <typename Callback>
+	std::size_t advance(std::uint64_t tick, Callback&& on_expiry);
+
+	/**
+	 * Returns the nearest tick that may have value expiry, but not greater than @c max_tick.
+	 * @note It may return tick of cascading when the nearest value is in upper level.
+	 */
+	std::uint64_t next_expiry_tick(std::uint64_t max_tick) const;
+
+	/**
+	 * Returns current tick.
+	 */
+	std::uint64_t current_tick() const;
+
+	/**
+	 * Returns number of value.
+	 */
+	std::size_t size() const;
+
+private:
+	static constexpr int LEVEL_NUM = 4;
+	static constexpr int SLOT_BITS = 8;
+	static constexpr int SLOT_NUM = 1 << SLOT_BITS;
+	static constexpr std::uint64_t SLOT_MASK = SLOT_NUM - 1;
+	static constexpr std::uint64_t MAX_DELTA = (std::uint64_t(1) << (SLOT_BITS * LEVEL_NUM)) - 1;
+	static constexpr std::int32_t NIL = -1;
+
+	enum NodeState : std::uint8_t
+	{
+		FREE,
+		LINKED,
+		EXPIRED, // Unlinked from slot and calling expiry callback.
+	};
+
+	struct Node
+	{
+		T value;
+		std::uint64_t expiry_tick;
+		std::uint32_t generation;
+		std::int32_t prev;
+		std::int32_t next;
+		std::uint8_t level;
+		std::uint8_t slot;
+		NodeState state;
+	};
+
+	/**
+	 * Returns index of node if handle is valid. Otherwise returns @c NIL.
+	 */
+	std::int32_t to_index(Handle handle) const;
+
+	Handle to_handle(std::int32_t index) const;
+
+	/**
+	 * Links node to slot according to expiry tick. Expiry tick must not before current tick.
+	 */
+	void link(std::int32_t index);
+
+	void unlink(std::int32_t index);
+
+	/**
+	 * Releases node to free list.
+	 */
+	void release(std::int32_t index);
+
+	/**
+	 * Moves all nodes of slot of level to lower level.
+	 */
+	void cascade(int level, std::size_t slot);
+
+	std::vector<Node> m_node_list;
+	std::vector<std::int32_t> m_free_list;
+	std::int32_t m_slot_list[LEVEL_NUM][SLOT_NUM];
+	std::size_t m_level_size[LEVEL_NUM];
+	std::uint64_t m_current_tick;
+	std::size_t m_size;
+};
+
+
+// ================================= Inline implement. =================================
+
+template <typename T>
+TimingWheel<T>::TimingWheel() :
+	m_node_list(),
+	m_free_list(),
+	m_level_size{0},
+	m_current_tick(0),
+	m_size(0)
+{
+	for (auto& slot_list : m_slot_list)
+	{
+		std::fill(std::begin(slot_list), std::end(slot_list), NIL);
+	}
+}
+
+
+template <typename T>
+typename TimingWheel<T>::Handle TimingWheel<T>::add(std::uint64_t expiry_tick, T value)
+{
+	std::int32_t index;
+	if (!m_free_list.empty())
+	{
+		index = m_free_list.back();
+		m_free_list.pop_back();
+	}
+	else
+	{
+		index = static_cast<std::int32_t>(m_node_list.size());
+		m_node_list.push_back(Node{T(), 0, 1, NIL, NIL, 0, 0, FREE});
+	}
+
+	Node& node = m_node_list[index];
+	node.value = std::move(value);
+	node.expiry_tick = std::max(expiry_tick, m_current_tick + 1);
+	link(index);
+	++m_size;
+	return to_handle(index);
+}
+
+
+template <typename T>
+bool TimingWheel<T>::rearm(Handle handle, std::uint64_t expiry_tick)
+{
+	std::int32_t index = to_index(handle);
+	if (index == NIL)
+	{
+		return false;
+	}
+
+	Node& node = m_node_list[index];
+	if (node.state == LINKED)
+	{
+		unlink(index);
+	}
+	node.expiry_tick = std::max(expiry_tick, m_current_tick + 1);
+	link(index);
+	return true;
+}
+
+
+template <typename T>
+bool TimingWheel<T>::remove(Handle handle)
+{
+	std::int32_t index = to_index(handle);
+	if (index == NIL)
+	{
+		return false;
+	}
+
+	if (m_node_list[index].state == LINKED)
+	{
+		unlink(index);
+	}
+	release(index);
+	return true;
+}
+
+
+template <typename T>
+T* TimingWheel<T>::find(Handle handle)
+{
+	std::int32_t index = to_index(handle);
+	if (index == NIL)
+	{
+		return nullptr;
+	}
+	return &m_node_list[index].value;
+}
+
+
+template <typename T>
+template <typename Callback>
+std::size_t TimingWheel<T>::advance(std::uint64_t tick, Callback&& on_expiry)
+{
+	std::size_t count = 0;
+	while (m_current_tick < tick)
+	{
+		if (m_size == 0)
+		{
+			m_current_tick = tick;
+			break;
+		}
+
+		// Skips ticks that have nothing to do until the tick before cascading.
+		if (m_level_size[0] == 0)
+		{
+			std::uint64_t skip_tick = std::min(tick, m_current_tick | SLOT_MASK);
+			if (skip_tick > m_current_tick)
+			{
+				m_current_tick = skip_tick;
+				continue;
+			}
+		}
+
+		++m_current_tick;
+		auto slot = static_cast<std::size_t>(m_current_tick & SLOT_MASK);
+		if (slot == 0)
+		{
+			for (int level = 1; level < LEVEL_NUM; ++level)
+			{
+				auto upper_slot = static_cast<std::size_t>((m_current_tick >> (SLOT_BITS * level)) & SLOT_MASK);
+				cascade(level, upper_slot);
+				if (upper_slot != 0)
+				{
+					break;
+				}
+			}
+		}
+
+		// Callback cannot add node to current slot, because new node expiry after current tick.
+		while (m_slot_list[0][slot] != NIL)
+		{
+			std::int32_t index = m_slot_list[0][slot];
+			unlink(index);
+			m_node_list[index].state = EXPIRED;
+			Handle handle = to_handle(index);
+			on_expiry(handle);
+			++count;
+
+			// Node may be removed or reused in callback.
+			if (to_index(handle) != NIL && m_node_list[index].state == EXPIRED)
+			{
+				release(index);
+			}
+		}
+	}
+	return count;
+}
+
+
+template <typename T>
+std::uint64_t TimingWheel<T>::next_expiry_tick(std::uint64_t max_tick) const
+{
+	if (m_size == 0)
+	{
+		return max_tick;
+	}
+
+	// Finds the nearest slot that have node in the lowest level.
+	std::uint64_t end_tick = std::min(max_tick, m_current_tick + SLOT_NUM - 1);
+	for (std::uint64_t tick = m_current_tick + 1; tick <= end_tick; ++tick)
+	{
+		if (m_slot_list[0][tick & SLOT_MASK] != NIL)
+		{
+			return tick;
+		}
+		// Upper level is cascaded at this tick.
+		if ((tick & SLOT_MASK) == 0)
+		{
+			return tick;
+		}
+	}
+	return end_tick;
+}
+
+
+template <typename T>
+std::uint64_t TimingWheel<T>::current_tick() const
+{
+	return m_current_tick;
+}
+
+
+template <typename T>
+std::size_t TimingWheel<T>::size() const
+{
+	return m_size;
+}
+
+
+template <typename T>
+std::int32_t TimingWheel<T>::to_index(Handle handle) const
+{
+	auto index = static_cast<std::int32_t>(handle & 0xFFFFFFFF);
+	auto generation = static_cast<std::uint32_t>(handle >> 32);
+	if (index < 0 || static_cast<std::size_t>(index) >= m_node_list.size())
+	{
+		return NIL;
+	}
+
+	const Node& node = m_node_list[index];
+	if (node.state == FREE || node.generation != generation)
+	{
+		return NIL;
+	}
+	return index;
+}
+
+
+template <typename T>
+typename TimingWheel<T>::Handle TimingWheel<T>::to_handle(std::int32_t index) const
+{
+	return (static_cast<Handle>(m_node_list[index].generation) << 32) | static_cast<std::uint32_t>(index);
+}
+
+
+template <typename T>
+void TimingWheel<T>::link(std::int32_t index)
+{
+	Node& node = m_node_list[index];
+	std::uint64_t delta = node.expiry_tick - m_current_tick;
+	if (delta > MAX_DELTA)
+	{
+		delta = MAX_DELTA;
+		node.expiry_tick = m_current_tick + MAX_DELTA;
+	}
+
+	int level = 0;
+	while (level < LEVEL_NUM - 1 && delta >= (std::uint64_t(1) << (SLOT_BITS * (level + 1))))
+	{
+		++level;
+	}
+	auto slot = static_cast<std::size_t>((node.expiry_tick >> (SLOT_BITS * level)) & SLOT_MASK);
+
+	node.level = static_cast<std::uint8_t>(level);
+	node.slot = static_cast<std::uint8_t>(slot);
+	node.state = LINKED;
+	node.prev = NIL;
+	node.next = m_slot_list[level][slot];
+	if (node.next != NIL)
+	{
+		m_node_list[node.next].prev = index;
+	}
+	m_slot_list[level][slot] = index;
+	++m_level_size[level];
+}
+
+
+template <typename T>
+void TimingWheel<T>::unlink(std::int32_t index)
+{
+	Node& node = m_node_list[index];
+	if (node.prev != NIL)
+	{
+		m_node_list[node.prev].next = node.next;
+	}
+	else
+	{
+		m_slot_list[node.level][node.slot] = node.next;
+	}
+
+	if (node.next != NIL)
+	{
+		m_node_list[node.next].prev = node.prev;
+	}
+
+	node.prev = NIL;
+	node.next = NIL;
+	--m_level_size[node.level];
+}
+
+
+template <typename T>
+void TimingWheel<T>::release(std::int32_t index)
+{
+	Node& node = m_node_list[index];
+	node.value = T();
+	node.state = FREE;
+	++node.generation;
+	if (node.generation == 0) // Handle never be zero.
+	{
+		node.generation = 1;
+	}
+	m_free_list.push_back(index);
+	--m_size;
+}
+
+
+template <typename T>
+void TimingWheel<T>::cascade(int level, std::size_t slot)
+{
+	std::int32_t index = m_slot_list[level][slot];
+	m_slot_list[level][slot] = NIL;
+	while (index != NIL)
+	{
+		std::int32_t next = m_node_list[index].next;
+		--m_level_size[level];
+		link(index);
+		index = next;
+	}
+}
+
+} // namespace spaceless
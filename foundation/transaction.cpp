@@ -7,8 +7,12 @@
 #include "transaction.h"
 
 #include <cassert>
+#include <atomic>
+#include <cstring>
+#include <algorithm>
 #include <protocol/all.h>
 
+#include "exception.h"
 #include "log.h"
 #include "actor_message.h"
 #include "worker.h"
@@ -17,6 +21,34 @@
 namespace spaceless {
 
 static Logger& logger = get_logger("worker");
+static thread_local lights::TextWriter error_msg;
+
+
+namespace details {
+
+const std::size_t TRANSACTION_SIZE_ALIGN = 16;
+
+// Transaction is created and destroyed in the same worker.
+static thread_local SizeClassPool transaction_pool(TRANSACTION_MAX_POOL_SIZE,
+												  TRANSACTION_SIZE_ALIGN,
+												  TRANSACTION_POOL_MAX_BLOCK);
+
+/**
+ * Collects response of batch entry that is dispatching.
+ */
+struct BatchCollector
+{
+	int conn_id;
+	int package_id; // Package of dispatching entry.
+	protocol::BatchEntry* entry; // It's nullptr after response is collected.
+};
+
+// Batch entry is dispatched synchronously, so each worker only has one collector at the same time.
+static thread_local BatchCollector* batch_collector = nullptr;
+
+static std::atomic<int> request_time_budget_ms(0);
+
+} // namespace details
 
 
 void Network::send_package(int conn_id, Package package, int service_id)
@@ -27,57 +59,175 @@ void Network::send_package(int conn_id, Package package, int service_id)
 	msg.conn_id = conn_id;
 	msg.package_id = package.package_id();
 	msg.service_id = service_id;
-	ActorMessageQueue::instance()->push(ActorMessageQueue::OUT_QUEUE, actor_msg);
+	CommandPriority priority = protocol::get_command_priority(package.header().base.command);
+	ActorMessageQueue::instance()->push(ActorMessageQueue::OUT_QUEUE, actor_msg, priority);
 }
 
 
-void Network::send_protocol(int conn_id,
-							const protocol::Message& msg,
-							int bind_trans_id,
-							int trigger_package_id,
-							int trigger_cmd,
-							int service_id)
+/**
+ * Returns command of message. RspError is converted to RspXXX that associate trigger command.
+ */
+static int get_message_command(const protocol::Message& msg, int trigger_cmd)
 {
-	const char* target_type = conn_id ? "Connection" : "Service";
-	int target_id = conn_id ? conn_id : service_id;
+	if (protocol::get_message_name(msg) == "RspError" && trigger_cmd != 0)
+	{
+		// Convert RspError to RspXXX that associate trigger cmd. So dependent on protocol message name.
+		auto msg_name = protocol::get_message_name(trigger_cmd);
+		msg_name.replace(0, 3, "Rsp");
+		return protocol::get_command(msg_name);
+	}
+	return protocol::get_command(msg);
+}
+
+
+/**
+ * Sets time budget of request. Request that is sent by multiply phase transaction uses remaining time of
+ * that transaction, so deadline of client is propagated to all relay requests.
+ */
+static void set_time_budget(Package& package, int bind_trans_id)
+{
+	int budget_ms = details::request_time_budget_ms.load(std::memory_order_relaxed);
+	MultiplyPhaseTransaction* trans = nullptr;
+	if (bind_trans_id != 0)
+	{
+		trans = MultiplyPhaseTransactionManager::instance()->find_transaction(bind_trans_id);
+	}
 
-	int size = protocol::get_message_size(msg);
-	if (static_cast<std::size_t>(size) > PackageBuffer::MAX_CONTENT_LEN)
+	if (trans != nullptr && trans->deadline_us() != 0)
 	{
-		LIGHTS_ERROR(logger, "{} {}: Content length is too large. length={}.", target_type, target_id, size);
-		return;
+		std::int64_t remain_us = trans->deadline_us() - lights::to_microsecond(lights::current_monotonic_time());
+		// Expired request still has the least budget to let receiver drop it and reply error.
+		budget_ms = static_cast<int>(std::max<std::int64_t>(1, (remain_us + 999) / 1000));
 	}
+	package.header().extend.time_budget_ms = budget_ms;
+}
 
-	Package package = PackageManager::instance()->register_package(size);
-	PackageHeader& header = package.header();
 
-	if (protocol::get_message_name(msg) == "RspError" && trigger_cmd != 0)
+/**
+ * Parses message as package. If @c content_field is not zero, @c content is append as external segment
+ * of that bytes field.
+ * @note Returns invalid package if parse failure.
+ */
+static Package make_protocol_package(const char* target_type,
+									 int target_id,
+									 const protocol::Message& msg,
+									 int trigger_package_id,
+									 int trigger_cmd,
+									 int content_field = 0,
+									 lights::Sequence content = lights::Sequence(nullptr, 0),
+									 Package::SegmentReleaser releaser = nullptr)
+{
+	int msg_size = protocol::get_message_size(msg);
+	int size = msg_size;
+	if (content_field != 0)
 	{
-		// Convert RspError to RspXXX that associate trigger cmd. So dependent on protocol message name.
-		auto msg_name = protocol::get_message_name(trigger_cmd);
-		msg_name.replace(0, 3, "Rsp");
-		header.base.command = protocol::get_command(msg_name);
-		LIGHTS_DEBUG(logger, "{} {}: Send package. cmd={}, name={}.", target_type, target_id, header.base.command, msg_name);
+		size += protocol::get_bytes_field_header_size(content_field, content.length());
+	}
+
+	std::size_t total_size = static_cast<std::size_t>(size) + content.length();
+	if (total_size > Package::MAX_STREAM_CONTENT_LEN)
+	{
+		LIGHTS_ERROR(logger, "{} {}: Content length is too large. length={}.", target_type, target_id, total_size);
+		if (releaser)
+		{
+			releaser(content);
+		}
+		return Package();
+	}
+
+	Package package;
+	if (content_field != 0)
+	{
+		// Message is serialized into head content and external content is send without copy.
+		package = PackageManager::instance()->register_segment_package(size);
+		package.append_segment(content, std::move(releaser));
+	}
+	// Large content uses stream package to avoid allocating huge contiguous buffer.
+	else if (static_cast<std::size_t>(size) > PackageBuffer::MAX_CONTENT_LEN)
+	{
+		package = PackageManager::instance()->register_stream_package(size);
 	}
 	else
 	{
-		auto& msg_name = protocol::get_message_name(msg);
-		header.base.command = protocol::get_command(msg_name);
-		LIGHTS_DEBUG(logger, "{} {}: Send package. cmd={}, name={}.", target_type, target_id, header.base.command, msg_name);
+		package = PackageManager::instance()->register_package(size);
 	}
+	PackageHeader& header = package.header();
+	header.base.command = get_message_command(msg, trigger_cmd);
+	LIGHTS_DEBUG(logger, "{} {}: Send package. cmd={}, name={}.",
+				 target_type, target_id, header.base.command, protocol::get_message_name(header.base.command));
 
-	header.base.content_length = size;
+	header.base.content_length = static_cast<int>(total_size);
 	header.extend.self_package_id = package.package_id();
 	header.extend.trigger_package_id = trigger_package_id;
 
-	bool ok = protocol::parse_to_sequence(msg, package.content_buffer());
+	bool ok;
+	if (content_field != 0)
+	{
+		// Field can appear after other fields, so external content field can be place at the end.
+		auto head_content = static_cast<char*>(package.content_buffer().data());
+		ok = protocol::parse_to_sequence(msg, {head_content, static_cast<std::size_t>(msg_size)});
+		protocol::write_bytes_field_header(content_field,
+										   content.length(),
+										   {head_content + msg_size, static_cast<std::size_t>(size - msg_size)});
+	}
+	else if (package.is_stream())
+	{
+		ok = protocol::parse_to_sequence(msg, package.content_list());
+	}
+	else
+	{
+		ok = protocol::parse_to_sequence(msg, package.content_buffer());
+	}
+
 	if (!ok)
 	{
 		LIGHTS_ERROR(logger, "{} {}: Parse to sequence failure. cmd={}.", target_type, target_id, header.base.command);
 		PackageManager::instance()->remove_package(package.package_id());
+		return Package();
+	}
+
+	return package;
+}
+
+
+void Network::send_protocol(int conn_id,
+							const protocol::Message& msg,
+							int bind_trans_id,
+							int trigger_package_id,
+							int trigger_cmd,
+							int service_id)
+{
+	const char* target_type = conn_id ? "Connection" : "Service";
+	int target_id = conn_id ? conn_id : service_id;
+
+	// Response of batch entry is collected into batch response instead of sending.
+	details::BatchCollector* collector = details::batch_collector;
+	if (collector != nullptr && conn_id == collector->conn_id && trigger_package_id == collector->package_id)
+	{
+		if (collector->entry == nullptr)
+		{
+			LIGHTS_ERROR(logger, "Connection {}: Batch entry already have response. trigger_cmd={}.", conn_id, trigger_cmd);
+			return;
+		}
+
+		collector->entry->set_command(get_message_command(msg, trigger_cmd));
+		msg.SerializeToString(collector->entry->mutable_content());
+		collector->entry = nullptr;
 		return;
 	}
 
+	Package package = make_protocol_package(target_type, target_id, msg, trigger_package_id, trigger_cmd);
+	if (!package.is_valid())
+	{
+		return;
+	}
+
+	// Only request has deadline.
+	if (trigger_package_id == 0)
+	{
+		set_time_budget(package, bind_trans_id);
+	}
+
 	if (bind_trans_id != 0)
 	{
 		MultiplyPhaseTransactionManager::instance()->bind_transaction(bind_trans_id, package.package_id());
@@ -87,6 +237,70 @@ void Network::send_protocol(int conn_id,
 }
 
 
+void Network::send_back_protocol_with_content(int conn_id,
+											  const protocol::Message& msg,
+											  Package trigger_package,
+											  int field_number,
+											  lights::Sequence content,
+											  Package::SegmentReleaser releaser)
+{
+	Package package = make_protocol_package("Connection",
+											conn_id,
+											msg,
+											trigger_package.header().extend.self_package_id,
+											trigger_package.header().base.command,
+											field_number,
+											content,
+											std::move(releaser));
+	if (!package.is_valid())
+	{
+		return;
+	}
+
+	send_package(conn_id, package);
+}
+
+
+void Network::set_request_time_budget(int budget_ms)
+{
+	details::request_time_budget_ms.store(std::max(0, budget_ms), std::memory_order_relaxed);
+}
+
+
+void Network::broadcast_package(const std::vector<int>& conn_list, Package package)
+{
+	if (conn_list.empty())
+	{
+		PackageManager::instance()->release_package(package.package_id());
+		return;
+	}
+
+	// Each connection release one reference after sending. Register package already have one reference.
+	int extra_count = static_cast<int>(conn_list.size()) - 1;
+	if (extra_count > 0)
+	{
+		PackageManager::instance()->retain_package(package.package_id(), extra_count);
+	}
+
+	for (int conn_id : conn_list)
+	{
+		send_package(conn_id, package);
+	}
+}
+
+
+void Network::broadcast_protocol(const std::vector<int>& conn_list, const protocol::Message& msg)
+{
+	Package package = make_protocol_package("Broadcast", static_cast<int>(conn_list.size()), msg, 0, 0);
+	if (!package.is_valid())
+	{
+		return;
+	}
+
+	broadcast_package(conn_list, package);
+}
+
+
 MultiplyPhaseTransaction::MultiplyPhaseTransaction(int trans_id) :
 	m_id(trans_id),
 	m_current_phase(0),
@@ -96,8 +310,51 @@ MultiplyPhaseTransaction::MultiplyPhaseTransaction(int trans_id) :
 	m_wait_conn_id(0),
 	m_wait_service_id (0),
 	m_wait_cmd(0),
-	m_is_waiting(false)
+	m_is_waiting(false),
+	m_wait_timer(INVALID_TIMER_HANDLE),
+	m_wait_start_time(),
+	m_start_time(),
+	m_deadline_us(0)
+{
+}
+
+
+void* TransactionAllocator::allocate(std::size_t size)
+{
+	return details::transaction_pool.allocate(size);
+}
+
+
+void TransactionAllocator::deallocate(void* trans, std::size_t size)
+{
+	details::transaction_pool.deallocate(trans, size);
+}
+
+
+const SizeClassPool::Stats& TransactionAllocator::stats()
 {
+	return details::transaction_pool.stats();
+}
+
+
+void* MultiplyPhaseTransaction::operator new(std::size_t size)
+{
+	return TransactionAllocator::allocate(size);
+}
+
+
+void MultiplyPhaseTransaction::operator delete(void* trans, std::size_t size)
+{
+	TransactionAllocator::deallocate(trans, size);
+}
+
+
+MultiplyPhaseTransaction::~MultiplyPhaseTransaction()
+{
+	if (m_wait_timer != INVALID_TIMER_HANDLE)
+	{
+		TimerManager::instance()->remove_timer(m_wait_timer);
+	}
 }
 
 
@@ -111,6 +368,8 @@ void MultiplyPhaseTransaction::pre_on_init(int conn_id, Package package)
 {
 	m_first_conn_id = conn_id;
 	m_first_trigger_source = package.get_trigger_source();
+	m_start_time = lights::current_monotonic_time();
+	m_deadline_us = package.deadline_us();
 }
 
 
@@ -120,7 +379,7 @@ void MultiplyPhaseTransaction::on_error(int conn_id, const ErrorInfo& error_info
 }
 
 
-void MultiplyPhaseTransaction::wait_next_phase(int conn_id, int cmd, OnActive on_active, int timeout, int service_id)
+void MultiplyPhaseTransaction::wait_next_phase(int conn_id, int cmd, OnActive on_active, int timeout_ms, int service_id)
 {
 	const char* target_type = conn_id ? "Connection" : "Service";
 	int target_id = conn_id ? conn_id : service_id;
@@ -141,10 +400,26 @@ void MultiplyPhaseTransaction::wait_next_phase(int conn_id, int cmd, OnActive on
 	++m_current_phase;
 	m_on_active = on_active;
 	m_is_waiting = true;
+	m_wait_start_time = lights::current_monotonic_time();
+
+	if (timeout_ms == ADAPTIVE_TIMEOUT)
+	{
+		timeout_ms = service_id != 0 ? MultiplyPhaseTransactionManager::instance()->adaptive_timeout(service_id) :
+									   DEFAULT_TIMEOUT;
+	}
+
+	// Timer of previous phase is useless.
+	auto timer_manager = TimerManager::instance();
+	if (m_wait_timer != INVALID_TIMER_HANDLE)
+	{
+		timer_manager->remove_timer(m_wait_timer);
+	}
 
 	int trans_id = m_id; // Cannot capture this. It maybe remove on timeout.
-	TimerManager::instance()->register_timer("wait_next_phase", lights::PreciseTime(timeout),
-											 [trans_id, target_type, target_id]()
+	// Timer is removed when transaction leaves waiting state, so it's only called when transaction is waiting.
+	lights::PreciseTime timeout(timeout_ms / 1000, lights::millisecond_to_nanosecond(timeout_ms % 1000));
+	m_wait_timer = timer_manager->register_timer("wait_next_phase", timeout,
+												 [trans_id, target_type, target_id]()
 	{
 		auto trans = MultiplyPhaseTransactionManager::instance()->find_transaction(trans_id);
 		if (!trans)
@@ -170,6 +445,17 @@ void MultiplyPhaseTransaction::wait_next_phase(int conn_id, int cmd, OnActive on
 }
 
 
+void MultiplyPhaseTransaction::clear_waiting_state()
+{
+	m_is_waiting = false;
+	if (m_wait_timer != INVALID_TIMER_HANDLE)
+	{
+		TimerManager::instance()->remove_timer(m_wait_timer);
+		m_wait_timer = INVALID_TIMER_HANDLE;
+	}
+}
+
+
 void MultiplyPhaseTransaction::send_back_error(const ErrorInfo& error_info)
 {
 	LIGHTS_ERROR(logger, "Connection {}: Transaction error. error_info={}:{}.",
@@ -180,15 +466,20 @@ void MultiplyPhaseTransaction::send_back_error(const ErrorInfo& error_info)
 }
 
 
-MultiplyPhaseTransaction& MultiplyPhaseTransactionManager::register_transaction(TransactionFatory trans_factory)
+MultiplyPhaseTransaction& MultiplyPhaseTransactionManager::register_transaction(const TransactionFatory& trans_factory)
 {
+	// Id zero is invalid, so skips it when id wraps.
+	if (m_next_id <= 0)
+	{
+		m_next_id = 1;
+	}
+
 	MultiplyPhaseTransaction* trans = trans_factory(m_next_id);
 	++m_next_id;
 
-	auto value = std::make_pair(trans->transaction_id(), trans);
-	auto result = m_trans_list.insert(value);
-	if (!result.second)
+	if (!m_trans_list.insert(trans->transaction_id(), trans))
 	{
+		delete trans;
 		SPACELESS_THROW(ERR_MULTIPLY_PHASE_TRANSACTION_ALREADY_EXIST);
 	}
 
@@ -201,22 +492,62 @@ void MultiplyPhaseTransactionManager::remove_transaction(int trans_id)
 	MultiplyPhaseTransaction* trans = find_transaction(trans_id);
 	if (trans != nullptr)
 	{
+		int cmd = trans->first_trigger_source().command;
+		if (cmd != 0)
+		{
+			std::int64_t end_to_end_us = lights::to_microsecond(lights::current_monotonic_time() - trans->start_time());
+			MonitorManager::instance()->record_latency(cmd, MonitorManager::END_TO_END_LATENCY, end_to_end_us);
+		}
+
+		m_trans_list.remove(trans_id);
 		delete trans;
 	}
+}
+
+
+void MultiplyPhaseTransactionManager::record_service_latency(int service_id, std::int64_t latency_us)
+{
+	ServiceLatency** latency = m_service_latency_table.find(service_id);
+	if (latency == nullptr)
+	{
+		m_service_latency_list.emplace_back(new ServiceLatency());
+		m_service_latency_table.insert(service_id, m_service_latency_list.back().get());
+		latency = m_service_latency_table.find(service_id);
+	}
 
-	m_trans_list.erase(trans_id);
+	LatencyHistogram& histogram = (*latency)->histogram;
+	histogram.record(latency_us);
+	// Derives timeout once in each window, so getting timeout never calculates percentile.
+	if (histogram.count() >= ADAPTIVE_TIMEOUT_WINDOW)
+	{
+		std::int64_t timeout_us = histogram.percentile(99) * ADAPTIVE_TIMEOUT_MULTIPLIER;
+		auto timeout_ms = static_cast<int>(std::min<std::int64_t>(timeout_us / 1000 + 1, ADAPTIVE_TIMEOUT_MAX_MS));
+		(*latency)->timeout_ms = std::max(timeout_ms, ADAPTIVE_TIMEOUT_MIN_MS);
+		histogram.reset();
+	}
+}
+
+
+int MultiplyPhaseTransactionManager::adaptive_timeout(int service_id)
+{
+	ServiceLatency** latency = m_service_latency_table.find(service_id);
+	if (latency == nullptr)
+	{
+		return MultiplyPhaseTransaction::DEFAULT_TIMEOUT;
+	}
+	return (*latency)->timeout_ms;
 }
 
 
 MultiplyPhaseTransaction* MultiplyPhaseTransactionManager::find_transaction(int trans_id)
 {
-	auto itr = m_trans_list.find(trans_id);
-	if (itr == m_trans_list.end())
+	auto trans = m_trans_list.find(trans_id);
+	if (trans == nullptr)
 	{
 		return nullptr;
 	}
 
-	return itr->second;
+	return *trans;
 }
 
 
@@ -228,30 +559,37 @@ std::size_t MultiplyPhaseTransactionManager::size()
 
 void MultiplyPhaseTransactionManager::bind_transaction(int trans_id, int package_id)
 {
-	auto value = std::make_pair(package_id, trans_id);
-	auto result = m_bind_list.insert(value);
-	if (!result.second)
+	if (!m_bind_list.insert(package_id, trans_id))
 	{
 		SPACELESS_THROW(ERR_BOUND_TRANSACTION_ALREADY_EXIST);
 	}
+	// Response of this package must be dispatched to the worker that own transaction.
+	WorkerScheduler::instance()->bind_package_owner(package_id);
 }
 
 
 void MultiplyPhaseTransactionManager::remove_bound_transaction(int package_id)
 {
-	m_bind_list.erase(package_id);
+	m_bind_list.remove(package_id);
+	WorkerScheduler::instance()->remove_package_owner(package_id);
 }
 
 
 MultiplyPhaseTransaction* MultiplyPhaseTransactionManager::find_bound_transaction(int package_id)
 {
-	auto itr = m_bind_list.find(package_id);
-	if (itr == m_bind_list.end())
+	auto trans_id = m_bind_list.find(package_id);
+	if (trans_id == nullptr)
 	{
 		return nullptr;
 	}
 
-	return find_transaction(itr->second);
+	return find_transaction(*trans_id);
+}
+
+
+std::size_t MultiplyPhaseTransactionManager::bound_size()
+{
+	return m_bind_list.size();
 }
 
 
@@ -264,18 +602,134 @@ void on_transaction_error(int conn_id, const PackageTriggerSource& trigger_sourc
 }
 
 
+/**
+ * Sets batch entry as error response.
+ */
+static void set_batch_error(protocol::BatchEntry& entry, ErrorCategory category, int code)
+{
+	protocol::RspError response;
+	response.mutable_error()->set_category(static_cast<std::int32_t>(category));
+	response.mutable_error()->set_code(code);
+	entry.set_command(protocol::get_command(response));
+	response.SerializeToString(entry.mutable_content());
+}
+
+
+void on_batch_transaction(int conn_id, Package package)
+{
+	protocol::ReqBatch request;
+	protocol::RspBatch response;
+	package.parse_to_protocol(request);
+
+	if (request.entry_list_size() > BATCH_MAX_ENTRY_NUM)
+	{
+		SPACELESS_THROW(ERR_BATCH_TOO_MANY_ENTRY);
+	}
+
+	std::size_t max_content_len = 0;
+	for (auto& entry : request.entry_list())
+	{
+		max_content_len = std::max(max_content_len, entry.content().size());
+	}
+	if (max_content_len > PackageBuffer::MAX_CONTENT_LEN)
+	{
+		max_content_len = PackageBuffer::MAX_CONTENT_LEN; // Larger entry is invalid.
+	}
+
+	// Entry is dispatched synchronously, so all entries reuse one package.
+	Package entry_package = PackageManager::instance()->register_package(static_cast<int>(max_content_len));
+	details::BatchCollector collector = {conn_id, entry_package.package_id(), nullptr};
+	details::batch_collector = &collector;
+
+	for (auto& entry : request.entry_list())
+	{
+		protocol::BatchEntry& response_entry = *response.add_entry_list();
+		int cmd = entry.command();
+		const Transaction* trans = nullptr;
+		if (cmd != package.header().base.command)
+		{
+			trans = TransactionManager::instance()->find_transaction(cmd);
+		}
+
+		// Entry that may reply after return cannot be dispatched, because its trigger package is reused.
+		const OnePhaseTransaction* trans_handler = nullptr;
+		if (trans != nullptr && trans->is_batch_entry)
+		{
+			trans_handler = std::get_if<OnePhaseTransaction>(&trans->trans_handler);
+		}
+
+		if (trans_handler == nullptr || entry.content().size() > max_content_len)
+		{
+			LIGHTS_ERROR(logger, "Connection {}: Invalid batch entry. cmd={}.", conn_id, cmd);
+			set_batch_error(response_entry, ErrorCategory::SPACELESS, ERR_BATCH_INVALID_ENTRY);
+			continue;
+		}
+
+		PackageHeader& header = entry_package.header();
+		header.base.command = cmd;
+		header.base.content_length = static_cast<int>(entry.content().size());
+		header.extend.self_package_id = entry_package.package_id();
+		header.extend.trigger_package_id = 0;
+		std::memcpy(entry_package.content_buffer().data(), entry.content().data(), entry.content().size());
+
+		collector.entry = &response_entry;
+		ErrorInfo error_info;
+		if (!safe_call([&]() { (*trans_handler)(conn_id, entry_package); }, error_msg, &error_info))
+		{
+			LIGHTS_ERROR(logger, "Connection {}: Batch entry error. cmd={}. {}.", conn_id, cmd, error_msg.c_str());
+			if (trans->error_handler)
+			{
+				bool success = safe_call([&]() {
+					trans->error_handler(conn_id, entry_package.get_trigger_source(), error_info);
+				}, error_msg);
+
+				if (!success)
+				{
+					LIGHTS_ERROR(logger, "Connection {}: Batch entry error handler error. cmd={}. {}.",
+								 conn_id, cmd, error_msg.c_str());
+				}
+			}
+		}
+
+		if (collector.entry != nullptr)
+		{
+			LIGHTS_ERROR(logger, "Connection {}: Batch entry have no response. cmd={}.", conn_id, cmd);
+			set_batch_error(response_entry, ErrorCategory::SPACELESS, ERR_BATCH_INVALID_ENTRY);
+			collector.entry = nullptr;
+		}
+	}
+
+	details::batch_collector = nullptr;
+	PackageManager::instance()->remove_package(entry_package.package_id());
+	Network::send_back_protocol(conn_id, response, package);
+}
+
+
 void TransactionManager::register_transaction(int cmd,
-											  TransactionType trans_type,
-											  std::any handler,
+											  TransactionHandler handler,
 											  TransactionErrorHandler error_handler)
 {
-	Transaction trans(trans_type, handler, error_handler);
-	auto value = std::make_pair(cmd, trans);
-	auto result = m_trans_list.insert(value);
-	if (!result.second)
+	if (find_transaction(cmd))
 	{
 		SPACELESS_THROW(ERR_TRANSACTION_ALREADY_EXIST);
 	}
+
+	if (m_trans_list.empty())
+	{
+		m_base_cmd = cmd;
+	}
+	else if (cmd < m_base_cmd)
+	{
+		m_trans_list.insert(m_trans_list.begin(), static_cast<std::size_t>(m_base_cmd - cmd), Transaction());
+		m_base_cmd = cmd;
+	}
+
+	auto index = static_cast<std::size_t>(cmd - m_base_cmd);
+	if (index >= m_trans_list.size())
+	{
+		m_trans_list.resize(index + 1);
+	}
+	m_trans_list[index] = Transaction{std::move(handler), std::move(error_handler)};
 }
 
 
@@ -283,7 +737,7 @@ void TransactionManager::register_one_phase_transaction(int cmd,
 														OnePhaseTransaction transaction,
 														TransactionErrorHandler error_handler)
 {
-	register_transaction(cmd, TransactionType::ONE_PHASE_TRANSACTION, transaction, error_handler);
+	register_transaction(cmd, std::move(transaction), std::move(error_handler));
 }
 
 
@@ -292,37 +746,48 @@ void TransactionManager::register_one_phase_transaction(const protocol::Message&
 														TransactionErrorHandler error_handler)
 {
 	auto cmd = protocol::get_command(msg);
-	register_one_phase_transaction(cmd, transaction, error_handler);
+	register_one_phase_transaction(cmd, std::move(transaction), std::move(error_handler));
 }
 
 
 void TransactionManager::register_multiply_phase_transaction(int cmd, TransactionFatory trans_factory)
 {
-	register_transaction(cmd, TransactionType::MULTIPLY_PHASE_TRANSACTION, trans_factory);
+	register_transaction(cmd, std::move(trans_factory));
 }
 
 
 void TransactionManager::register_multiply_phase_transaction(const protocol::Message& msg, TransactionFatory trans_factory)
 {
 	auto cmd = protocol::get_command(msg);
-	register_multiply_phase_transaction(cmd, trans_factory);
+	register_multiply_phase_transaction(cmd, std::move(trans_factory));
 }
 
 
-void TransactionManager::remove_transaction(int cmd)
+void TransactionManager::register_batch_entry(int cmd)
 {
-	m_trans_list.erase(cmd);
+	auto index = static_cast<std::size_t>(static_cast<unsigned>(cmd - m_base_cmd));
+	if (index >= m_trans_list.size() || !std::holds_alternative<OnePhaseTransaction>(m_trans_list[index].trans_handler))
+	{
+		SPACELESS_THROW(ERR_BATCH_INVALID_ENTRY);
+	}
+	m_trans_list[index].is_batch_entry = true;
 }
 
 
-Transaction* TransactionManager::find_transaction(int cmd)
+void TransactionManager::register_batch_entry(const protocol::Message& msg)
 {
-	auto itr = m_trans_list.find(cmd);
-	if (itr == m_trans_list.end())
+	auto cmd = protocol::get_command(msg);
+	register_batch_entry(cmd);
+}
+
+
+void TransactionManager::remove_transaction(int cmd)
+{
+	auto index = static_cast<std::size_t>(static_cast<unsigned>(cmd - m_base_cmd));
+	if (index < m_trans_list.size())
 	{
-		return nullptr;
+		m_trans_list[index] = Transaction();
 	}
-	return &itr->second;
 }
 
 } // namespace spaceless
\ No newline at end of file
@@ -6,9 +6,10 @@
 
 #pragma once
 
-#include <map>
+#include <vector>
+#include <memory>
 #include <functional>
-#include <any>
+#include <variant>
 
 #include <protocol/message_declare.h>
 #include <protocol/command.h>
@@ -16,6 +17,11 @@
 #include "basics.h"
 #include "package.h"
 #include "monitor.h"
+#include "worker.h"
+#include "function_ref.h"
+#include "id_table.h"
+#include "size_class_pool.h"
+#include "latency_histogram.h"
 
 
 namespace spaceless {
@@ -71,11 +77,43 @@ public:
 								   const PackageTriggerSource& trigger_source,
 								   int bind_trans_id = 0);
 
+	/**
+	 * Parses message as package and appends external content as bytes field of message without copy,
+	 * then send to remote asynchronously and send back request transaction id.
+	 * @param conn_id          Network connection id.
+	 * @param msg              Protocol message. The field of @c field_number must not be set.
+	 * @param trigger_package  The package that trigger current transaction.
+	 * @param field_number     Number of bytes field that external content is belong to.
+	 * @param content          External memory that must keep valid until @c releaser is call.
+	 * @param releaser         Releases external memory after package is sent. It may be call in network thread.
+	 */
+	static void send_back_protocol_with_content(int conn_id,
+												const protocol::Message& msg,
+												Package trigger_package,
+												int field_number,
+												lights::Sequence content,
+												Package::SegmentReleaser releaser);
+
 	/**
 	 * Sends package to remote asynchronously.
 	 */
 	static void service_send_package(int service_id, Package package);
 
+	/**
+	 * Sends one package to multiple remote asynchronously. The package is shared by all connection
+	 * and will be destroyed after the last connection finish sending.
+	 * @param conn_list  List of network connection id.
+	 * @param package    Package that already fill content.
+	 */
+	static void broadcast_package(const std::vector<int>& conn_list, Package package);
+
+	/**
+	 * Parses message as package buffer only once and send to multiple remote asynchronously.
+	 * @param conn_list  List of network connection id.
+	 * @param msg        Protocol message.
+	 */
+	static void broadcast_protocol(const std::vector<int>& conn_list, const protocol::Message& msg);
+
 	/**
 	 * Parses message as package buffer and send to remote asynchronously.
 	 * @param service_id         Network service id.
@@ -83,6 +121,13 @@ public:
 	 * @param bind_trans_id      Specific transaction that trigger by response.
 	 */
 	static void service_send_protocol(int service_id, const protocol::Message& msg, int bind_trans_id = 0);
+
+	/**
+	 * Sets time budget of request that is not sent by multiply phase transaction. Request that is sent by
+	 * multiply phase transaction uses remaining time of that transaction.
+	 * @param budget_ms  Time budget in millisecond. Zero means request have no deadline.
+	 */
+	static void set_request_time_budget(int budget_ms);
 	
 	/**
 	 * Service only can use to send package, but cannot send back message.
@@ -97,7 +142,9 @@ public:
 class MultiplyPhaseTransaction
 {
 public:
-	static const int DEFAULT_TIMEOUT = 1;
+	static const int DEFAULT_TIMEOUT = 1000; // Millisecond.
+	// Timeout of waiting service is derived from response latency of that service.
+	static const int ADAPTIVE_TIMEOUT = -1;
 
 	/**
 	 * Checks on active callback is valid.
@@ -179,9 +226,19 @@ public:
 	MultiplyPhaseTransaction(const MultiplyPhaseTransaction&) = delete;
 
 	/**
-	 * Destroys transaction.
+	 * Destroys transaction and cancels timeout timer of waiting.
 	 */
-	virtual ~MultiplyPhaseTransaction() = default;
+	virtual ~MultiplyPhaseTransaction();
+
+	/**
+	 * Allocates transaction object from pool of current worker.
+	 */
+	static void* operator new(std::size_t size);
+
+	/**
+	 * Returns transaction object to pool of current worker.
+	 */
+	static void operator delete(void* trans, std::size_t size);
 
 	/**
 	 * Initializes this base class internal variables.
@@ -205,37 +262,37 @@ public:
 	 * @param conn_id       Network connection that send indicate package.
 	 * @param cmd           Waits command.
 	 * @param on_active     Callback of on active.
-	 * @param timeout       Timeout of waiting next package.
+	 * @param timeout_ms    Timeout in millisecond of waiting next package.
 	 * @param service_id    Network service that send indicate package. Uses to replace conn_id.
 	 */
-	void wait_next_phase(int conn_id, int cmd, OnActive on_active, int timeout = DEFAULT_TIMEOUT, int service_id = 0);
+	void wait_next_phase(int conn_id, int cmd, OnActive on_active, int timeout_ms = DEFAULT_TIMEOUT, int service_id = 0);
 
 	/**
 	 * Sets wait package info.
 	 * @param conn_id       Network connection that send indicate package.
 	 * @param msg           Waits protocol message.
 	 * @param on_active     Callback of on active.
-	 * @param timeout       Timeout of waiting next package.
+	 * @param timeout_ms    Timeout in millisecond of waiting next package.
 	 */
-	void wait_next_phase(int conn_id, const protocol::Message& msg, OnActive on_active, int timeout = DEFAULT_TIMEOUT);
+	void wait_next_phase(int conn_id, const protocol::Message& msg, OnActive on_active, int timeout_ms = DEFAULT_TIMEOUT);
 
 	/**
 	 * Sets wait package info.
 	 * @param service_id    Network service that send indicate package.
 	 * @param cmd           Waits command.
 	 * @param on_active     Callback of on active.
-	 * @param timeout       Timeout of waiting next package.
+	 * @param timeout_ms    Timeout in millisecond of waiting next package.
 	 */
-	void service_wait_next_phase(int service_id, int cmd, OnActive on_active, int timeout = DEFAULT_TIMEOUT);
+	void service_wait_next_phase(int service_id, int cmd, OnActive on_active, int timeout_ms = DEFAULT_TIMEOUT);
 
 	/**
 	 * Sets wait package info.
 	 * @param service_id    Network service that send indicate package.
 	 * @param cmd           Waits protocol message.
 	 * @param on_active     Callback of on active.
-	 * @param timeout       Timeout of waiting next package.
+	 * @param timeout_ms    Timeout in millisecond of waiting next package.
 	 */
-	void service_wait_next_phase(int service_id, const protocol::Message& msg, OnActive on_active, int timeout = DEFAULT_TIMEOUT);
+	void service_wait_next_phase(int service_id, const protocol::Message& msg, OnActive on_active, int timeout_ms = DEFAULT_TIMEOUT);
 
 	/**
 	 * Sends back message to first connection.
@@ -272,6 +329,22 @@ public:
 	 */
 	const PackageTriggerSource& first_trigger_source() const;
 
+	/**
+	 * Returns monotonic time point that this transaction start.
+	 */
+	lights::PreciseTime start_time() const;
+
+	/**
+	 * Returns monotonic time point that start to wait next phase.
+	 */
+	lights::PreciseTime wait_start_time() const;
+
+	/**
+	 * Returns local monotonic time in microsecond that request of first phase expire.
+	 * Returns zero if have no deadline.
+	 */
+	std::int64_t deadline_us() const;
+
 	/**
 	 * Returns waiting connection id that set by @c wait_next_phase
 	 */
@@ -293,7 +366,7 @@ public:
 	bool is_waiting() const;
 
 	/**
-	 * Clears waiting state.
+	 * Clears waiting state and cancels timeout timer of waiting.
 	 */
 	void clear_waiting_state();
 
@@ -307,6 +380,34 @@ private:
 	int m_wait_service_id;
 	int m_wait_cmd;
 	bool m_is_waiting;
+	TimerHandle m_wait_timer;
+	lights::PreciseTime m_wait_start_time;
+	lights::PreciseTime m_start_time;
+	std::int64_t m_deadline_us;
+};
+
+
+/**
+ * Allocator of multiply phase transaction object. Object is recycled by size class in each worker, so creating
+ * transaction never allocates memory after warming up.
+ */
+class TransactionAllocator
+{
+public:
+	/**
+	 * Gets object from pool of current thread or allocates new object.
+	 */
+	static void* allocate(std::size_t size);
+
+	/**
+	 * Returns object to pool of current thread.
+	 */
+	static void deallocate(void* trans, std::size_t size);
+
+	/**
+	 * Returns statistics of pool of current thread.
+	 */
+	static const SizeClassPool::Stats& stats();
 };
 
 
@@ -317,17 +418,24 @@ using TransactionFatory = std::function<MultiplyPhaseTransaction*(int trans_id)>
 
 
 /**
- * Manager of multiply phase transaction.
+ * Manager of multiply phase transaction. Transaction and bound relationship are stored in flat table that
+ * indexed by id.
+ * @note Each worker has its own transaction manager.
  */
 class MultiplyPhaseTransactionManager
 {
 public:
-	SPACELESS_SINGLETON_INSTANCE(MultiplyPhaseTransactionManager);
+	/**
+	 * Returns transaction manager of current worker.
+	 * @throw Throws exception if current thread is not a worker. Network and compute thread must delegate
+	 *        to worker by @c Delegation.
+	 */
+	static MultiplyPhaseTransactionManager* instance();
 
 	/**
 	 * Registers multiply phase transaction.
 	 */
-	MultiplyPhaseTransaction& register_transaction(TransactionFatory trans_factory);
+	MultiplyPhaseTransaction& register_transaction(const TransactionFatory& trans_factory);
 
 	/**
 	 * Removes multiply phase transaction.
@@ -361,52 +469,87 @@ public:
 	 */
 	MultiplyPhaseTransaction* find_bound_transaction(int package_id);
 
+	/**
+	 * Returns number of bound relationship.
+	 */
+	std::size_t bound_size();
+
+	/**
+	 * Records response latency of service.
+	 * @note Waiting that timeout is not recorded. Otherwise stalled service raises its own timeout.
+	 */
+	void record_service_latency(int service_id, std::int64_t latency_us);
+
+	/**
+	 * Returns timeout in millisecond of waiting service. It's multiple of p99 of response latency of the last
+	 * window, so loaded service has longer timeout and fast service is detected quickly when it stalls.
+	 * Stalled service keeps timeout of the last window, because timeout is not recorded as latency.
+	 * @note Returns default timeout before service have enough response.
+	 */
+	int adaptive_timeout(int service_id);
+
 private:
+	struct ServiceLatency
+	{
+		LatencyHistogram histogram;
+		int timeout_ms = MultiplyPhaseTransaction::DEFAULT_TIMEOUT;
+	};
+
 	int m_next_id = 1;
-	std::map<int, MultiplyPhaseTransaction*> m_trans_list;
-	std::map<int, int> m_bind_list;
+	IdTable<MultiplyPhaseTransaction*> m_trans_list;
+	IdTable<int> m_bind_list;
+	std::vector<std::unique_ptr<ServiceLatency>> m_service_latency_list;
+	IdTable<ServiceLatency*> m_service_latency_table;
 };
 
 
 using OnePhaseTransaction = std::function<void(int conn_id, Package package)>;
 
 
-/**
- * Transaction type.
- */
-enum class TransactionType
-{
-	ONE_PHASE_TRANSACTION,
-	MULTIPLY_PHASE_TRANSACTION,
-};
-
-
 using TransactionErrorHandler = std::function<void(int conn_id,
 												   const PackageTriggerSource& trigger_source,
 												   const ErrorInfo& error_info)>;
 
 void on_transaction_error(int conn_id, const PackageTriggerSource& trigger_source, const ErrorInfo& error_info);
 
+/**
+ * Dispatches entries of @c protocol::ReqBatch to one phase transaction in order and replies all responses
+ * in one @c protocol::RspBatch.
+ * @note Only transaction that is registered as batch entry can be dispatched, other entry is replied with error.
+ *       Because entry must reply before dispatching return.
+ */
+void on_batch_transaction(int conn_id, Package package);
+
+/**
+ * Non-owning reference of transaction error handler.
+ */
+using TransactionErrorHandlerRef = FunctionRef<void(int conn_id,
+													const PackageTriggerSource& trigger_source,
+													const ErrorInfo& error_info)>;
+
+
+/**
+ * Handler of transaction. It's one phase transaction or factory of multiply phase transaction.
+ * @c std::monostate means have no transaction.
+ */
+using TransactionHandler = std::variant<std::monostate, OnePhaseTransaction, TransactionFatory>;
+
 
 /**
  * General transaction type.
  */
 struct Transaction
 {
-	Transaction(TransactionType trans_type, std::any trans_handler, TransactionErrorHandler error_handler) :
-		trans_type(trans_type),
-		trans_handler(trans_handler),
-		error_handler(error_handler)
-	{}
-
-	TransactionType trans_type;
-	std::any trans_handler;
+	TransactionHandler trans_handler;
 	TransactionErrorHandler error_handler;
+	bool is_batch_entry = false; // Can be dispatched as entry of batch.
 };
 
 
 /**
  * Manager of transaction. When receive a command will trigger associated transaction.
+ * Command is dense small integer, so transaction is stored in flat array that indexed by command.
+ * @note Transaction must be registered before scheduler start, because finding transaction is not locked.
  */
 class TransactionManager
 {
@@ -419,8 +562,7 @@ public:
      * @throw Throws exception if register failure.
 	 */
 	void register_transaction(int cmd,
-							  TransactionType trans_type,
-							  std::any handler,
+							  TransactionHandler handler,
 							  TransactionErrorHandler error_handler = nullptr);
 
 	/**
@@ -446,6 +588,15 @@ public:
 
 	void register_multiply_phase_transaction(const protocol::Message& msg, TransactionFatory trans_factory);
 
+	/**
+	 * Registers one phase transaction as batch entry. That transaction must always reply before return,
+	 * because response of entry is collected before dispatching return.
+	 * @throw Throws exception if transaction is not one phase transaction.
+	 */
+	void register_batch_entry(int cmd);
+
+	void register_batch_entry(const protocol::Message& msg);
+
 	/**
 	 * Removes association of command with transaction.
 	 */
@@ -455,10 +606,12 @@ public:
 	 * Finds transaction that associate with command.
 	 * @note Return nullptr if cannot find command.
 	 */
-	Transaction* find_transaction(int cmd);
+	const Transaction* find_transaction(int cmd) const;
 
 private:
-	std::map<int, Transaction> m_trans_list;
+	// Command of the first element of transaction list.
+	int m_base_cmd = 0;
+	std::vector<Transaction> m_trans_list;
 };
 
 
@@ -468,6 +621,9 @@ private:
 #define SPACELESS_REG_MULTIPLE_TRANS(ProtocolType, ...) \
 		TransactionManager::instance()->register_multiply_phase_transaction(ProtocolType(), __VA_ARGS__)
 
+#define SPACELESS_REG_BATCH_ENTRY(ProtocolType) \
+		TransactionManager::instance()->register_batch_entry(ProtocolType())
+
 
 // ================================= Inline implement. =================================
 
@@ -505,24 +661,24 @@ inline void Network::service_send_protocol(int service_id, const protocol::Messa
 inline void MultiplyPhaseTransaction::wait_next_phase(int conn_id,
 													  const protocol::Message& msg,
 													  OnActive on_active,
-													  int timeout)
+													  int timeout_ms)
 {
 	auto cmd = protocol::get_command(msg);
-	wait_next_phase(conn_id, cmd, on_active, timeout);
+	wait_next_phase(conn_id, cmd, on_active, timeout_ms);
 }
 
-inline void MultiplyPhaseTransaction::service_wait_next_phase(int service_id, int cmd, OnActive on_active, int timeout)
+inline void MultiplyPhaseTransaction::service_wait_next_phase(int service_id, int cmd, OnActive on_active, int timeout_ms)
 {
-	wait_next_phase(0, cmd, on_active, timeout, service_id);
+	wait_next_phase(0, cmd, on_active, timeout_ms, service_id);
 }
 
 inline void MultiplyPhaseTransaction::service_wait_next_phase(int service_id,
 															  const protocol::Message& msg,
 															  OnActive on_active,
-															  int timeout)
+															  int timeout_ms)
 {
 	auto cmd = protocol::get_command(msg);
-	service_wait_next_phase(service_id, cmd, on_active, timeout);
+	service_wait_next_phase(service_id, cmd, on_active, timeout_ms);
 }
 
 inline void MultiplyPhaseTransaction::send_back_message(const protocol::Message& msg)
@@ -555,6 +711,21 @@ inline const PackageTriggerSource& MultiplyPhaseTransaction::first_trigger_sourc
 	return m_first_trigger_source;
 }
 
+inline lights::PreciseTime MultiplyPhaseTransaction::start_time() const
+{
+	return m_start_time;
+}
+
+inline lights::PreciseTime MultiplyPhaseTransaction::wait_start_time() const
+{
+	return m_wait_start_time;
+}
+
+inline std::int64_t MultiplyPhaseTransaction::deadline_us() const
+{
+	return m_deadline_us;
+}
+
 inline int MultiplyPhaseTransaction::waiting_connection_id() const
 {
 	return m_wait_conn_id;
@@ -575,9 +746,22 @@ inline bool MultiplyPhaseTransaction::is_waiting() const
 	return m_is_waiting;
 }
 
-inline void MultiplyPhaseTransaction::clear_waiting_state()
+
+inline const Transaction* TransactionManager::find_transaction(int cmd) const
 {
-	m_is_waiting = false;
+	// Command that less than base command is converted to large index.
+	auto index = static_cast<std::size_t>(static_cast<unsigned>(cmd - m_base_cmd));
+	if (index >= m_trans_list.size())
+	{
+		return nullptr;
+	}
+
+	const Transaction& trans = m_trans_list[index];
+	if (std::holds_alternative<std::monostate>(trans.trans_handler))
+	{
+		return nullptr;
+	}
+	return &trans;
 }
 
 } // namespace spaceless
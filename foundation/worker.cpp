@@ -8,29 +8,39 @@
 
 #include <atomic>
 #include <functional>
+#include <memory>
+#include <map>
+#include <unordered_map>
+#include <mutex>
+#include <string>
+#include <algorithm>
 
 #include <Poco/Runnable.h>
 #include <Poco/Thread.h>
 #include <sys/prctl.h>
 
 #include "log.h"
+#include "exception.h"
 #include "package.h"
 #include "actor_message.h"
 #include "transaction.h"
 #include "monitor.h"
+#include "thread_placement.h"
+#include "rsa_key_pool.h"
 
 
 namespace spaceless {
 
 static Logger& logger = get_logger("worker");
-static lights::TextWriter error_msg;
+// Each worker uses its own error message buffer.
+static thread_local lights::TextWriter error_msg;
 
 namespace details {
 
 class Worker: public Poco::Runnable
 {
 public:
-	SPACELESS_SINGLETON_INSTANCE(Worker)
+	explicit Worker(int index);
 
 	virtual void run();
 
@@ -42,100 +52,326 @@ public:
 		STOPPED,
 	};
 
+	/**
+	 * Statistics of busy loop that uses to tune budget of batch.
+	 */
+	struct LoopStats
+	{
+		std::size_t loop_count = 0;
+		std::size_t message_count = 0;
+		std::size_t max_batch_size = 0;
+		lights::PreciseTime total_loop_time;
+		lights::PreciseTime max_loop_time;
+	};
+
+	int index;
+	LoopStats loop_stats;
+	// Number of request that is dropped because of exceeding deadline.
+	std::size_t expired_request_count = 0;
 	std::atomic<int> run_state = ATOMIC_VAR_INIT(STOPPED);
 	std::atomic<bool> stop_flag = ATOMIC_VAR_INIT(false);
+	TimerManager timer_manager;
+	MultiplyPhaseTransactionManager trans_manager;
+	// Monitor constructor need timer manager, so create it after worker is ready.
+	std::unique_ptr<MonitorManager> monitor_manager;
 
 private:
+	/**
+	 * Processes message until queue is empty or use up budget of batch.
+	 * @return Number of message that processed.
+	 */
+	std::size_t process_message_batch(lights::PreciseTime begin_time);
+
+	/**
+	 * Records statistics of a busy loop.
+	 */
+	void record_loop(std::size_t batch_size, lights::PreciseTime loop_time);
+
+	/**
+	 * Logs statistics of loop and resets it.
+	 */
+	void log_loop_stats();
+
 	void process_message(const ActorMessage& actor_msg);
 
-	void trigger_transaction(int conn_id, int service_id, int package_id);
+	/**
+	 * Triggers transaction of network message and records latency of command.
+	 */
+	void trigger_transaction(const ActorMessage::NetworkMsg& msg);
 
+	/**
+	 * Drops request that exceed deadline and replies error instead of dispatching it.
+	 */
+	void drop_expired_request(int conn_id, const Package& package);
+
+	/**
+	 * Calls transaction function and calls error handler when function throws exception.
+	 * @note Function and error handler are only referenced, so calling transaction never allocates memory.
+	 */
 	bool call_transaction(int conn_id,
 						  int trans_id,
-						  Package package,
-						  TransactionErrorHandler error_handler,
-						  std::function<void()> function);
+						  const Package& package,
+						  TransactionErrorHandlerRef error_handler,
+						  FunctionRef<void()> function);
 
 	const std::string& get_name(int cmd);
 };
 
 
+/**
+ * Pool of worker and routing information of message.
+ */
+class WorkerPool
+{
+public:
+	SPACELESS_SINGLETON_INSTANCE(WorkerPool);
+
+	WorkerPool();
+
+	// Worker is not destroyed when resize to avoid dangling pointer that is using by other.
+	std::unique_ptr<Worker> worker_list[WORKER_MAX_NUM];
+	int worker_count;
+	std::size_t batch_max_count;
+	lights::PreciseTime batch_max_time;
+	std::map<int, WorkerScheduler::ShardKeyFunction> shard_key_list;
+	// Package id that bound transaction to index of worker that own transaction.
+	std::unordered_map<int, int> package_owner_list;
+	std::mutex package_owner_mutex;
+};
+
+
+static thread_local Worker* current_worker = nullptr;
+
+
+/**
+ * Returns worker that run in current thread.
+ * @throw Throws exception if current thread is not a worker. Other thread must delegate to worker.
+ */
+Worker* get_current_worker()
+{
+	if (current_worker == nullptr)
+	{
+		SPACELESS_THROW(ERR_WORKER_NOT_CURRENT_THREAD);
+	}
+	return current_worker;
+}
+
+
+/**
+ * Converts microsecond to precise time.
+ */
+lights::PreciseTime to_precise_time(std::int64_t microsecond)
+{
+	const std::int64_t MICROSECONDS_OF_SECOND = 1000000;
+	return lights::PreciseTime(microsecond / MICROSECONDS_OF_SECOND,
+							   lights::microsecond_to_nanosecond(microsecond % MICROSECONDS_OF_SECOND));
+}
+
+
+WorkerPool::WorkerPool() :
+	worker_count(1),
+	batch_max_count(WORKER_BATCH_MAX_COUNT),
+	batch_max_time(to_precise_time(WORKER_BATCH_MAX_TIME_US))
+{
+	worker_list[0].reset(new Worker(0));
+}
+
+
+Worker::Worker(int index) :
+	index(index),
+	loop_stats(),
+	timer_manager(),
+	trans_manager(),
+	monitor_manager()
+{
+}
+
+
 void Worker::run()
 {
+	current_worker = this;
 	run_state = STARTED;
-	prctl(PR_SET_NAME, WORKER_THREAD_NAME);
+	std::string thread_name = WORKER_THREAD_NAME;
+	if (WorkerPool::instance()->worker_count > 1)
+	{
+		thread_name += std::to_string(index);
+	}
+	prctl(PR_SET_NAME, thread_name.c_str());
+	ThreadPlacement::instance()->apply(ThreadType::WORKER, index, thread_name);
 
-	LIGHTS_INFO(logger, "Running worker.");
+	LIGHTS_INFO(logger, "Running worker {}.", index);
 
-	// Package manager instance may be create in network thread. But monitor only can be use in worker thread.
-	SPACELESS_REG_MONITOR(PackageManager);
+	if (index == 0)
+	{
+		// Package manager instance may be create in network thread. But monitor only can be use in worker thread.
+		SPACELESS_REG_MONITOR(PackageManager);
+		MonitorManager::instance()->register_monitor("PackageMemorySize", []
+		{
+			return PackageManager::instance()->memory_size();
+		});
+		MonitorManager::instance()->register_monitor("PackageMemoryBudgetUsage", []
+		{
+			return PackageManager::instance()->memory_budget_usage();
+		});
+		MonitorManager::instance()->register_monitor("RsaKeyPoolSize", []
+		{
+			return RsaKeyPool::instance()->size();
+		});
+		MonitorManager::instance()->register_monitor("RsaKeyPoolDry", []
+		{
+			return RsaKeyPool::instance()->dry_count();
+		});
+	}
 	// Monitor constructor need timer manager. If register in timer constructor will lead to dead lock.
 	SPACELESS_REG_MONITOR(TimerManager);
 	SPACELESS_REG_MONITOR(MultiplyPhaseTransactionManager);
+	MonitorManager::instance()->register_monitor("BoundTransaction", []
+	{
+		return MultiplyPhaseTransactionManager::instance()->bound_size();
+	});
+	MonitorManager::instance()->register_monitor("TransactionPoolInUse", []
+	{
+		return TransactionAllocator::stats().in_use_count;
+	});
+	MonitorManager::instance()->register_monitor("TransactionPoolCached", []
+	{
+		return TransactionAllocator::stats().cached_count;
+	});
+	MonitorManager::instance()->register_monitor("TransactionPoolHeapAlloc", []
+	{
+		return TransactionAllocator::stats().heap_alloc_count;
+	});
+	MonitorManager::instance()->register_monitor("TransactionPoolReuse", []
+	{
+		return TransactionAllocator::stats().reuse_count;
+	});
+	MonitorManager::instance()->register_monitor("ExpiredRequest", [this]
+	{
+		return expired_request_count;
+	});
 
-	int idle_times = 0;
-	while (!stop_flag)
+	timer_manager.register_frequent_timer("WorkerLoopStats", lights::PreciseTime(WORKER_LOOP_STATS_PER_SEC), [this]
 	{
-		bool have_message = false;
-		if (!ActorMessageQueue::instance()->empty(ActorMessageQueue::IN_QUEUE))
-		{
-			have_message = true;
-			auto msg = ActorMessageQueue::instance()->pop(ActorMessageQueue::IN_QUEUE);
-			process_message(msg);
-		}
+		log_loop_stats();
+	});
 
-		int expiry_count = TimerManager::instance()->process_expiry_timer();
-		bool have_expiry_time = expiry_count != 0;
+	auto max_wait_time = to_precise_time(lights::millisecond_to_microsecond(WORKER_MAX_WAIT_MS));
+	auto begin_time = lights::current_monotonic_time();
+	while (!stop_flag)
+	{
+		std::size_t batch_size = process_message_batch(begin_time);
+		// Services all due timer after batch instead of after each message.
+		int expiry_count = timer_manager.process_expiry_timer();
 
-		if (!have_message && !have_expiry_time)
+		if (batch_size == 0 && expiry_count == 0)
 		{
-			long time = WORKER_IDLE_SLEEP_MS;
-			++idle_times;
-			if (idle_times > WORKER_LONG_IDLE_TIMES)
-			{
-				time = WORKER_LONG_IDLE_SLEEP_MS;
-				idle_times = 0;
-			}
-
-			Poco::Thread::current()->sleep(time);
+			// Blocks until message arrive or the nearest timer expiry instead of polling.
+			auto timeout = timer_manager.next_expiry_interval(max_wait_time);
+			ActorMessageQueue::instance()->wait(ActorMessageQueue::IN_QUEUE, timeout, static_cast<std::size_t>(index));
+			begin_time = lights::current_monotonic_time();
 		}
 		else
 		{
-			idle_times = 0;
+			// End time of this loop is begin time of next loop.
+			auto end_time = lights::current_monotonic_time();
+			record_loop(batch_size, end_time - begin_time);
+			begin_time = end_time;
 		}
 	}
 
-	LIGHTS_INFO(logger, "Stopped worker.");
+	LIGHTS_INFO(logger, "Stopped worker {}.", index);
 	run_state = STOPPED;
 }
 
 
+std::size_t Worker::process_message_batch(lights::PreciseTime begin_time)
+{
+	auto pool = WorkerPool::instance();
+	auto deadline = begin_time + pool->batch_max_time;
+	auto channel = static_cast<std::size_t>(index);
+
+	std::size_t count = 0;
+	ActorMessage msg;
+	while (count < pool->batch_max_count && ActorMessageQueue::instance()->pop(ActorMessageQueue::IN_QUEUE, msg, channel))
+	{
+		process_message(msg);
+		++count;
+
+		// Reads clock periodically to avoid reading it for each message.
+		if (count % WORKER_BATCH_TIME_CHECK_PERIOD == 0 && deadline < lights::current_monotonic_time())
+		{
+			break;
+		}
+	}
+	return count;
+}
+
+
+void Worker::record_loop(std::size_t batch_size, lights::PreciseTime loop_time)
+{
+	++loop_stats.loop_count;
+	loop_stats.message_count += batch_size;
+	loop_stats.max_batch_size = std::max(loop_stats.max_batch_size, batch_size);
+	loop_stats.total_loop_time = loop_stats.total_loop_time + loop_time;
+	if (loop_stats.max_loop_time < loop_time)
+	{
+		loop_stats.max_loop_time = loop_time;
+	}
+}
+
+
+void Worker::log_loop_stats()
+{
+	std::size_t loop_count = loop_stats.loop_count;
+	if (loop_count == 0)
+	{
+		return;
+	}
+
+	std::size_t avg_batch_size = loop_stats.message_count / loop_count;
+	std::int64_t avg_loop_us = lights::to_microsecond(loop_stats.total_loop_time) / static_cast<std::int64_t>(loop_count);
+	LIGHTS_INFO(logger, "Worker {}: Loop stats. loop_count={}, message_count={}, avg_batch_size={}, max_batch_size={}, "
+		"avg_loop_us={}, max_loop_us={}.",
+				index,
+				loop_count,
+				loop_stats.message_count,
+				avg_batch_size,
+				loop_stats.max_batch_size,
+				avg_loop_us,
+				lights::to_microsecond(loop_stats.max_loop_time));
+	loop_stats = LoopStats();
+}
+
+
 void Worker::process_message(const ActorMessage& actor_msg)
 {
 	switch (actor_msg.type)
 	{
 		case ActorMessage::NETWORK_TYPE:
 		{
-			auto& msg = actor_msg.network_msg;
-			trigger_transaction(msg.conn_id, msg.service_id, msg.package_id);
+			trigger_transaction(actor_msg.network_msg);
 			break;
 		}
 
 		case ActorMessage::DELEGATE_TYPE:
 		{
 			auto& msg = actor_msg.delegate_msg;
-			if (!safe_call(msg.function, error_msg))
+			if (!safe_call([&msg]() { (*msg.function)(); }, error_msg))
 			{
 				LIGHTS_ERROR(logger, "Delegation {}: {}.", msg.caller, error_msg.c_str());
 			}
+			DelegateFunction::destroy(msg.function);
 			break;
 		}
 	}
 }
 
 
-void Worker::trigger_transaction(int conn_id, int service_id, int package_id)
+void Worker::trigger_transaction(const ActorMessage::NetworkMsg& msg)
 {
+	int conn_id = msg.conn_id;
+	int service_id = msg.service_id;
+	int package_id = msg.package_id;
 	Package package = PackageManager::instance()->find_package(package_id);
 	if (!package.is_valid())
 	{
@@ -146,67 +382,72 @@ void Worker::trigger_transaction(int conn_id, int service_id, int package_id)
 	int command = package.header().base.command;
 	int trigger_package_id = package.header().extend.trigger_package_id;
 
+	auto begin_time = lights::current_monotonic_time();
+	if (msg.push_time_us != 0)
+	{
+		std::int64_t queue_us = lights::to_microsecond(begin_time) - msg.push_time_us;
+		monitor_manager->record_latency(command, MonitorManager::QUEUE_LATENCY, queue_us);
+	}
+	bool is_handled = false;
+
 	MultiplyPhaseTransaction* waiting_trans = nullptr;
 	if (trigger_package_id != 0)
 	{
 		waiting_trans = MultiplyPhaseTransactionManager::instance()->find_bound_transaction(trigger_package_id);
 	}
 
-	if (waiting_trans == nullptr) // Create new transaction.
+	std::int64_t deadline_us = package.deadline_us();
+	if (waiting_trans == nullptr && deadline_us != 0 && deadline_us < lights::to_microsecond(begin_time))
+	{
+		drop_expired_request(conn_id, package);
+	}
+	else if (waiting_trans == nullptr) // Create new transaction.
 	{
 		auto trans = TransactionManager::instance()->find_transaction(command);
 		if (trans != nullptr)
 		{
-			switch (trans->trans_type)
+			// Handler is used by reference, because it's not changed after scheduler start.
+			if (auto trans_handler = std::get_if<OnePhaseTransaction>(&trans->trans_handler))
+			{
+				LIGHTS_DEBUG(logger, "Connection {}: Receive package. cmd={}, name={}.",
+							 conn_id, command, get_name(command));
+
+				call_transaction(conn_id, 0, package, trans->error_handler, [&]()
+				{
+					(*trans_handler)(conn_id, package);
+				});
+				is_handled = true;
+			}
+			else if (auto trans_factory = std::get_if<TransactionFatory>(&trans->trans_handler))
 			{
-				case TransactionType::ONE_PHASE_TRANSACTION:
+				auto& trans_handler = MultiplyPhaseTransactionManager::instance()->register_transaction(*trans_factory);
+				int trans_id = trans_handler.transaction_id();
+
+				LIGHTS_DEBUG(logger, "Connection {}: Receive package. cmd={}, name={}. Transaction start. trans_id={}.",
+							 conn_id,
+							 command,
+							 get_name(command),
+							 trans_id);
+				trans_handler.pre_on_init(conn_id, package);
+
+				auto error_handler = [&](int conn_id,
+										 const PackageTriggerSource& trigger_source,
+										 const ErrorInfo& error_info)
 				{
-					LIGHTS_DEBUG(logger, "Connection {}: Receive package. cmd={}, name={}.",
-								 conn_id, command, get_name(command));
-					auto trans_handler = std::any_cast<OnePhaseTransaction>(trans->trans_handler);
+					trans_handler.on_error(conn_id, error_info);
+				};
 
-					call_transaction(conn_id, 0, package, trans->error_handler, [&]()
-					{
-						trans_handler(conn_id, package);
-					});
+				call_transaction(conn_id, trans_id, package, error_handler, [&]()
+				{
+					trans_handler.on_init(conn_id, package);
+				});
+				is_handled = true;
 
-					break;
-				}
-				case TransactionType::MULTIPLY_PHASE_TRANSACTION:
+				if (!trans_handler.is_waiting())
 				{
-					auto trans_factory = std::any_cast<TransactionFatory>(trans->trans_handler);
-					auto& trans_handler = MultiplyPhaseTransactionManager::instance()->register_transaction(trans_factory);
-					int trans_id = trans_handler.transaction_id();
-
-					LIGHTS_DEBUG(logger, "Connection {}: Receive package. cmd={}, name={}. Transaction start. trans_id={}.",
-								 conn_id,
-								 command,
-								 get_name(command),
-								 trans_id);
-					trans_handler.pre_on_init(conn_id, package);
-
-					auto error_handler = [&](int conn_id,
-											 const PackageTriggerSource& trigger_source,
-											 const ErrorInfo& error_info)
-					{
-						trans_handler.on_error(conn_id, error_info);
-					};
-
-					call_transaction(conn_id, trans_id, package, error_handler, [&]()
-					{
-						trans_handler.on_init(conn_id, package);
-					});
-
-					if (!trans_handler.is_waiting())
-					{
-						LIGHTS_DEBUG(logger, "Connection {}: Transaction end. trans_id={}.", conn_id, trans_id);
-						MultiplyPhaseTransactionManager::instance()->remove_transaction(trans_id);
-					}
-					break;
+					LIGHTS_DEBUG(logger, "Connection {}: Transaction end. trans_id={}.", conn_id, trans_id);
+					MultiplyPhaseTransactionManager::instance()->remove_transaction(trans_id);
 				}
-				default:
-					LIGHTS_ASSERT(false && "Invalid TransactionType");
-					break;
 			}
 		}
 		else
@@ -244,6 +485,13 @@ void Worker::trigger_transaction(int conn_id, int service_id, int package_id)
 			// 2. If after on_active is at waiting, transaction will be remove on timeout
 			//    that cannot receive message by connection close.
 
+			if (waiting_trans->waiting_service_id() != 0)
+			{
+				lights::PreciseTime latency = begin_time - waiting_trans->wait_start_time();
+				MultiplyPhaseTransactionManager::instance()->record_service_latency(waiting_trans->waiting_service_id(),
+																					lights::to_microsecond(latency));
+			}
+
 			waiting_trans->clear_waiting_state();
 
 			auto error_handler = [&](int conn_id,
@@ -258,6 +506,7 @@ void Worker::trigger_transaction(int conn_id, int service_id, int package_id)
 				auto callback = waiting_trans->on_active().get_callback();
 				(waiting_trans->*callback)(conn_id, package);
 			});
+			is_handled = true;
 
 			if (!waiting_trans->is_waiting())
 			{
@@ -280,22 +529,45 @@ void Worker::trigger_transaction(int conn_id, int service_id, int package_id)
 		MultiplyPhaseTransactionManager::instance()->remove_bound_transaction(trigger_package_id);
 	}
 
+	if (is_handled)
+	{
+		std::int64_t handle_us = lights::to_microsecond(lights::current_monotonic_time() - begin_time);
+		monitor_manager->record_latency(command, MonitorManager::HANDLE_LATENCY, handle_us);
+	}
+
 	PackageManager::instance()->remove_package(package_id);
 }
 
 
+void Worker::drop_expired_request(int conn_id, const Package& package)
+{
+	++expired_request_count;
+	int command = package.header().base.command;
+	LIGHTS_DEBUG(logger, "Connection {}: Drop expired request. cmd={}, name={}.", conn_id, command, get_name(command));
+
+	bool success = safe_call([&]() {
+		on_transaction_error(conn_id, package.get_trigger_source(), to_error_info(ERR_TRANSACTION_DEADLINE_EXCEEDED));
+	}, error_msg);
+
+	if (!success)
+	{
+		LIGHTS_ERROR(logger, "Connection {}: Reply expired request error. cmd={}. {}.", conn_id, command, error_msg.c_str());
+	}
+}
+
+
 bool Worker::call_transaction(int conn_id,
 							  int trans_id,
-							  Package package,
-							  TransactionErrorHandler error_handler,
-							  std::function<void()> function)
+							  const Package& package,
+							  TransactionErrorHandlerRef error_handler,
+							  FunctionRef<void()> function)
 {
 	ErrorInfo error_info;
 	if (!safe_call(function, error_msg, &error_info))
 	{
 		LIGHTS_ERROR(logger, "Connection {}: Transaction error. trans_id={}. {}.", conn_id, trans_id, error_msg.c_str());
 
-		if (error_handler != nullptr)
+		if (error_handler)
 		{
 			bool success = safe_call([&]() {
 				error_handler(conn_id, package.get_trigger_source(), error_info);
@@ -330,21 +602,28 @@ const std::string& Worker::get_name(int cmd)
 void WorkerScheduler::start()
 {
 	using namespace details;
-	auto worker = Worker::instance();
-	if (worker->run_state == Worker::STOPPED)
+	auto pool = WorkerPool::instance();
+	if (pool->worker_list[0]->run_state == Worker::STARTED)
 	{
-		worker->run_state = Worker::STARTING;
-		LIGHTS_INFO(logger, "Starting worker scheduler.");
-
-		// Use static to avoid destroy thread and throw NullPointerException (Poco internal bug).
-		// Because new thread will use this thread object data. When it destroy before get it's internal data
-		// will get a null data and throw NullPointerException when use it.
-		static Poco::Thread thread;
-		thread.start(*worker);
+		LIGHTS_ASSERT(false && "Worker already started");
+		return;
 	}
-	else if (worker->run_state == Worker::STARTED)
+
+	LIGHTS_INFO(logger, "Starting worker scheduler. worker_count={}.", pool->worker_count);
+
+	// Use static to avoid destroy thread and throw NullPointerException (Poco internal bug).
+	// Because new thread will use this thread object data. When it destroy before get it's internal data
+	// will get a null data and throw NullPointerException when use it.
+	static Poco::Thread thread_list[WORKER_MAX_NUM];
+	for (int i = 0; i < pool->worker_count; ++i)
 	{
-		LIGHTS_ASSERT(false && "Worker already started");
+		Worker& worker = *pool->worker_list[i];
+		if (worker.run_state == Worker::STOPPED)
+		{
+			worker.run_state = Worker::STARTING;
+			worker.stop_flag = false;
+			thread_list[i].start(worker);
+		}
 	}
 }
 
@@ -352,12 +631,17 @@ void WorkerScheduler::start()
 void WorkerScheduler::stop()
 {
 	using namespace details;
-	auto worker = Worker::instance();
-	if (worker->run_state == Worker::STARTED)
+	auto pool = WorkerPool::instance();
+	for (int i = 0; i < pool->worker_count; ++i)
 	{
-		worker->stop_flag = true;
-		worker->run_state = Worker::STOPPING;
-		LIGHTS_INFO(logger, "Stopping worker scheduler.");
+		Worker& worker = *pool->worker_list[i];
+		if (worker.run_state == Worker::STARTED)
+		{
+			worker.stop_flag = true;
+			worker.run_state = Worker::STOPPING;
+			LIGHTS_INFO(logger, "Stopping worker {}.", i);
+			ActorMessageQueue::instance()->notify(ActorMessageQueue::IN_QUEUE, static_cast<std::size_t>(i));
+		}
 	}
 }
 
@@ -365,100 +649,276 @@ void WorkerScheduler::stop()
 bool WorkerScheduler::is_worker_running()
 {
 	using namespace details;
-	return Worker::instance()->run_state != Worker::STOPPED;
+	auto pool = WorkerPool::instance();
+	for (int i = 0; i < pool->worker_count; ++i)
+	{
+		if (pool->worker_list[i]->run_state != Worker::STOPPED)
+		{
+			return true;
+		}
+	}
+	return false;
 }
 
 
-int TimerManager::register_timer(lights::StringView caller,
-								 lights::PreciseTime interval,
-								 std::function<void()> expiry_action,
-								 TimerCallPolicy call_policy,
-								 lights::PreciseTime delay)
+void WorkerScheduler::set_batch_budget(std::size_t max_count, int max_time_us)
 {
-	if (delay.seconds == 0)
+	auto pool = details::WorkerPool::instance();
+	pool->batch_max_count = std::max(max_count, static_cast<std::size_t>(1));
+	pool->batch_max_time = details::to_precise_time(max_time_us);
+}
+
+
+void WorkerScheduler::set_worker_count(int count)
+{
+	using namespace details;
+	auto pool = WorkerPool::instance();
+	count = std::max(1, std::min(count, WORKER_MAX_NUM));
+	for (int i = pool->worker_count; i < count; ++i)
 	{
-		delay = interval;
+		if (!pool->worker_list[i])
+		{
+			pool->worker_list[i].reset(new Worker(i));
+		}
 	}
+	pool->worker_count = count;
+	ActorMessageQueue::instance()->set_channel_count(ActorMessageQueue::IN_QUEUE, static_cast<std::size_t>(count));
+}
 
-	lights::PreciseTime expiry_time = lights::current_precise_time() + delay;
 
-	Timer timer = {
-		m_next_id,
-		interval,
-		expiry_time,
-		expiry_action,
-		call_policy,
-		caller,
-	};
+int WorkerScheduler::worker_count()
+{
+	return details::WorkerPool::instance()->worker_count;
+}
+
 
-	++m_next_id;
-	m_timer_queue.push_back(timer);
-	std::push_heap(m_timer_queue.begin(), m_timer_queue.end(), TimerCompare());
-	return timer.timer_id;
+int WorkerScheduler::current_worker_index()
+{
+	return details::get_current_worker()->index;
+}
+
+
+bool WorkerScheduler::is_worker_thread()
+{
+	return details::current_worker != nullptr;
 }
 
 
-int TimerManager::register_frequent_timer(lights::StringView caller,
-										  lights::PreciseTime interval,
-										  std::function<void()> expiry_action,
-										  lights::PreciseTime delay)
+void WorkerScheduler::set_shard_key_function(int cmd, ShardKeyFunction function)
 {
-	return register_timer(caller, interval, expiry_action, TimerCallPolicy::CALL_FREQUENTLY, delay);
+	details::WorkerPool::instance()->shard_key_list[cmd] = function;
 }
 
 
-void TimerManager::remove_timer(int time_id)
+int WorkerScheduler::dispatch_worker(int conn_id, const Package& package)
 {
-	auto itr = std::remove_if(m_timer_queue.begin(), m_timer_queue.end(), [&](const Timer& timer)
+	using namespace details;
+	auto pool = WorkerPool::instance();
+	if (pool->worker_count == 1)
 	{
-		return timer.timer_id == time_id;
-	});
+		return 0;
+	}
+
+	const PackageHeader& header = package.header();
+	int trigger_package_id = header.extend.trigger_package_id;
+	if (trigger_package_id != 0)
+	{
+		std::lock_guard<std::mutex> lock(pool->package_owner_mutex);
+		auto itr = pool->package_owner_list.find(trigger_package_id);
+		if (itr != pool->package_owner_list.end())
+		{
+			return itr->second;
+		}
+	}
+
+	int shard_key = conn_id;
+	auto itr = pool->shard_key_list.find(header.base.command);
+	if (itr != pool->shard_key_list.end())
+	{
+		ErrorInfo error_info;
+		int key = 0;
+		if (safe_call([&]() { key = itr->second(conn_id, package); }, error_msg, &error_info))
+		{
+			shard_key = key;
+		}
+		else
+		{
+			LIGHTS_ERROR(logger, "Connection {}: Get shard key error. cmd={}. {}.",
+						 conn_id, header.base.command, error_msg.c_str());
+		}
+	}
+
+	return static_cast<int>(static_cast<unsigned int>(shard_key) % static_cast<unsigned int>(pool->worker_count));
+}
+
 
-	if (itr == m_timer_queue.end())
+void WorkerScheduler::bind_package_owner(int package_id)
+{
+	using namespace details;
+	auto pool = WorkerPool::instance();
+	if (pool->worker_count == 1)
 	{
 		return;
 	}
 
-	m_timer_queue.erase(itr);
-	std::make_heap(m_timer_queue.begin(), m_timer_queue.end(), TimerCompare());
+	int index = get_current_worker()->index;
+	std::lock_guard<std::mutex> lock(pool->package_owner_mutex);
+	pool->package_owner_list[package_id] = index;
 }
 
 
-int TimerManager::process_expiry_timer()
+void WorkerScheduler::remove_package_owner(int package_id)
 {
-	if (m_timer_queue.empty())
+	using namespace details;
+	auto pool = WorkerPool::instance();
+	if (pool->worker_count == 1)
 	{
-		return 0;
+		return;
 	}
 
-	// Need to copy.
-	Timer top = m_timer_queue.front();
-	if (lights::current_precise_time() < top.expiry_time)
+	std::lock_guard<std::mutex> lock(pool->package_owner_mutex);
+	pool->package_owner_list.erase(package_id);
+}
+
+
+TimerManager* TimerManager::instance()
+{
+	return &details::get_current_worker()->timer_manager;
+}
+
+
+MultiplyPhaseTransactionManager* MultiplyPhaseTransactionManager::instance()
+{
+	return &details::get_current_worker()->trans_manager;
+}
+
+
+MonitorManager* MonitorManager::instance()
+{
+	auto worker = details::get_current_worker();
+	if (!worker->monitor_manager)
 	{
-		return 0;
+		worker->monitor_manager.reset(new MonitorManager());
 	}
+	return worker->monitor_manager.get();
+}
+
+
+TimerManager::TimerManager() :
+	m_start_time(lights::current_monotonic_time()),
+	m_timer_wheel()
+{
+}
 
-	if (!safe_call(top.expiry_action, error_msg))
+
+TimerHandle TimerManager::register_timer(lights::StringView caller,
+										 lights::PreciseTime interval,
+										 std::function<void()> expiry_action,
+										 TimerCallPolicy call_policy,
+										 lights::PreciseTime delay)
+{
+	if (delay.seconds == 0 && delay.nanoseconds == 0)
 	{
-		LIGHTS_ERROR(logger, "Timer {}: {}", top.caller, error_msg.c_str());
+		delay = interval;
 	}
 
-	std::pop_heap(m_timer_queue.begin(), m_timer_queue.end(), TimerCompare());
-	m_timer_queue.pop_back();
+	auto now = lights::current_monotonic_time();
+	Timer timer = {
+		to_tick(interval, true),
+		std::move(expiry_action),
+		call_policy,
+		caller,
+	};
+
+	// Rounds up expiry time to avoid expiry earlier than delay.
+	std::uint64_t expiry_tick = to_tick(now - m_start_time + delay, true);
+	return m_timer_wheel.add(expiry_tick, std::move(timer));
+}
+
+
+TimerHandle TimerManager::register_frequent_timer(lights::StringView caller,
+												  lights::PreciseTime interval,
+												  std::function<void()> expiry_action,
+												  lights::PreciseTime delay)
+{
+	return register_timer(caller, interval, std::move(expiry_action), TimerCallPolicy::CALL_FREQUENTLY, delay);
+}
+
+
+void TimerManager::remove_timer(TimerHandle handle)
+{
+	m_timer_wheel.remove(handle);
+}
+
+
+int TimerManager::process_expiry_timer()
+{
+	auto now_tick = to_tick(lights::current_monotonic_time() - m_start_time, false);
+	auto count = m_timer_wheel.advance(now_tick, [&](TimerHandle handle)
+	{
+		// Moves out action, because expiry action may register or remove timer.
+		Timer* timer = m_timer_wheel.find(handle);
+		std::function<void()> expiry_action = std::move(timer->expiry_action);
+		lights::StringView caller = timer->caller;
+		if (!safe_call(expiry_action, error_msg))
+		{
+			LIGHTS_ERROR(logger, "Timer {}: {}", caller, error_msg.c_str());
+		}
+
+		// Timer is invalid if it's removed by its expiry action.
+		timer = m_timer_wheel.find(handle);
+		if (timer && timer->call_policy == TimerCallPolicy::CALL_FREQUENTLY)
+		{
+			timer->expiry_action = std::move(expiry_action);
+			m_timer_wheel.rearm(handle, now_tick + timer->interval_tick);
+		}
+	});
+	return static_cast<int>(count);
+}
+
 
-	if (top.call_policy == TimerCallPolicy::CALL_FREQUENTLY)
+lights::PreciseTime TimerManager::next_expiry_interval(lights::PreciseTime max_interval)
+{
+	if (m_timer_wheel.size() == 0)
+	{
+		return max_interval;
+	}
+
+	auto now_tick = to_tick(lights::current_monotonic_time() - m_start_time, false);
+	auto max_tick = now_tick + to_tick(max_interval, false);
+	auto expiry_tick = m_timer_wheel.next_expiry_tick(max_tick);
+	if (expiry_tick <= now_tick)
 	{
-		top.expiry_time = lights::current_precise_time() + top.interval;
-		m_timer_queue.push_back(top);
-		std::push_heap(m_timer_queue.begin(), m_timer_queue.end(), TimerCompare());
+		return lights::PreciseTime(0);
 	}
-	return 1;
+
+	auto interval_ms = static_cast<std::int64_t>(expiry_tick - now_tick) * TIMER_TICK_MS;
+	auto interval = details::to_precise_time(lights::millisecond_to_microsecond(interval_ms));
+	return interval < max_interval ? interval : max_interval;
 }
 
 
 std::size_t TimerManager::size()
 {
-	return m_timer_queue.size();
+	return m_timer_wheel.size();
+}
+
+
+std::uint64_t TimerManager::to_tick(lights::PreciseTime duration, bool round_up)
+{
+	const std::int64_t MICROSECONDS_OF_TICK = lights::millisecond_to_microsecond(TIMER_TICK_MS);
+	std::int64_t microsecond = lights::to_microsecond(duration);
+	if (microsecond <= 0)
+	{
+		return 0;
+	}
+
+	std::int64_t tick = microsecond / MICROSECONDS_OF_TICK;
+	if (round_up && microsecond % MICROSECONDS_OF_TICK != 0)
+	{
+		++tick;
+	}
+	return static_cast<std::uint64_t>(tick);
 }
 
 } // namespace spaceless
\ No newline at end of file
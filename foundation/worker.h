@@ -12,6 +12,8 @@
 #include <lights/precise_time.h>
 
 #include "basics.h"
+#include "package.h"
+#include "timing_wheel.h"
 
 
 /**
@@ -20,13 +22,22 @@
 namespace spaceless {
 
 /**
- * Schedule worker execution.
+ * Schedule worker execution. There is a pool of worker and each worker runs in its own thread. Network message
+ * is dispatched to worker by shard key, so messages of the same key are always processed in order by one worker.
+ * Each worker has its own timer manager and multiply phase transaction manager, so transaction and its timeout
+ * always stay on the worker that create it.
  */
 class WorkerScheduler
 {
 public:
 	SPACELESS_SINGLETON_INSTANCE(WorkerScheduler);
 
+	/**
+	 * Returns shard key of package. Package that have same shard key is processed by same worker.
+	 * @note It's called in network thread.
+	 */
+	using ShardKeyFunction = std::function<int(int conn_id, const Package& package)>;
+
 	/**
 	 * Starts to schedule worker. Worker is running in other thread.
 	 */
@@ -42,6 +53,56 @@ public:
 	 * Check worker is running.
 	 */
 	bool is_worker_running();
+
+	/**
+	 * Sets budget of processing message in each loop of worker. Worker services expiry timer after processing
+	 * @c max_count messages or after processing message for @c max_time_us microsecond.
+	 * @note Must set before start.
+	 */
+	void set_batch_budget(std::size_t max_count, int max_time_us);
+
+	/**
+	 * Sets number of worker.
+	 * @note Must set before start and before any message is pushed. Count is limited by @c WORKER_MAX_NUM.
+	 */
+	void set_worker_count(int count);
+
+	/**
+	 * Returns number of worker.
+	 */
+	int worker_count();
+
+	/**
+	 * Returns index of worker that run in current thread. Returns zero if current thread is not a worker.
+	 */
+	int current_worker_index();
+
+	/**
+	 * Checks current thread is a worker.
+	 */
+	bool is_worker_thread();
+
+	/**
+	 * Sets function to get shard key of package of command. Default shard key is connection id.
+	 * @note Must set before start.
+	 */
+	void set_shard_key_function(int cmd, ShardKeyFunction function);
+
+	/**
+	 * Gets index of worker that process package.
+	 * @note Response of package that bound transaction is dispatched to the worker that own transaction.
+	 */
+	int dispatch_worker(int conn_id, const Package& package);
+
+	/**
+	 * Records current worker own the transaction that bound on package.
+	 */
+	void bind_package_owner(int package_id);
+
+	/**
+	 * Removes owner of package.
+	 */
+	void remove_package_owner(int package_id);
 };
 
 
@@ -52,48 +113,75 @@ enum class TimerCallPolicy : bool
 };
 
 
+/**
+ * Handle of timer. Handle of removed timer never refers to other timer.
+ */
+using TimerHandle = std::uint64_t;
+
+const TimerHandle INVALID_TIMER_HANDLE = 0;
+
+
 /**
  * Manager of all timer. And provide basic scheduling function.
- * @note TimerManager are scheduling by worker.
+ * Timer is stored in hierarchical timing wheel in unit of @c TIMER_TICK_MS, so register and remove timer are O(1).
+ * Time is read from precise monotonic clock, because coarse clock advances in several milliseconds that is
+ * larger than tick.
+ * @note TimerManager are scheduling by worker. Each worker has its own timer manager.
  */
 class TimerManager
 {
 public:
-	SPACELESS_SINGLETON_INSTANCE(TimerManager);
+	/**
+	 * Returns timer manager of current worker.
+	 * @throw Throws exception if current thread is not a worker. Network and compute thread must delegate
+	 *        to worker by @c Delegation.
+	 */
+	static TimerManager* instance();
+
+	/**
+	 * Creates timer manager that tick start from now.
+	 */
+	TimerManager();
 
 	/**
 	 * Registers timer and call @c expiry_action at time expiry.
 	 * @param delay Default is using value of @c interval.
-	 * @return Returns time id.
+	 * @return Returns handle of timer.
 	 */
-	int register_timer(lights::StringView caller,
-					   lights::PreciseTime interval,
-					   std::function<void()> expiry_action,
-					   TimerCallPolicy call_policy = TimerCallPolicy::CALL_ONCE,
-					   lights::PreciseTime delay = lights::PreciseTime(0));
+	TimerHandle register_timer(lights::StringView caller,
+							   lights::PreciseTime interval,
+							   std::function<void()> expiry_action,
+							   TimerCallPolicy call_policy = TimerCallPolicy::CALL_ONCE,
+							   lights::PreciseTime delay = lights::PreciseTime(0));
 
 	/**
 	 * Registers timer and call @c expiry_action at time expiry.
 	 * @param delay Default is using value of @c interval.
-	 * @return Returns time id.
+	 * @return Returns handle of timer.
 	 */
-	int register_frequent_timer(lights::StringView caller,
-								lights::PreciseTime interval,
-								std::function<void()> expiry_action,
-								lights::PreciseTime delay = lights::PreciseTime(0));
+	TimerHandle register_frequent_timer(lights::StringView caller,
+										lights::PreciseTime interval,
+										std::function<void()> expiry_action,
+										lights::PreciseTime delay = lights::PreciseTime(0));
 
 	/**
-	 * Removes timer.
+	 * Removes timer. It's safe to remove timer that already expiry or removed.
 	 */
-	void remove_timer(int time_id);
+	void remove_timer(TimerHandle handle);
 
 	/**
-	 * Process expiry timer if have.
+	 * Process all expiry timer in one pass. Current time is only read once in the pass.
 	 * @return Count of timer expiry.
 	 * @note Only use in internal.
 	 */
 	int process_expiry_timer();
 
+	/**
+	 * Returns interval from now to the nearest expiry time, but not greater than @c max_interval.
+	 * @note Returns zero if any timer already expiry.
+	 */
+	lights::PreciseTime next_expiry_interval(lights::PreciseTime max_interval);
+
 	/**
 	 * Returns number of timer.
 	 */
@@ -102,24 +190,20 @@ public:
 private:
 	struct Timer
 	{
-		int timer_id;
-		lights::PreciseTime interval;
-		lights::PreciseTime expiry_time;
+		std::uint64_t interval_tick;
 		std::function<void()> expiry_action;
 		TimerCallPolicy call_policy;
-		lights::StringView caller;
+		lights::StringView caller = "";
 	};
 
-	struct TimerCompare
-	{
-		bool operator()(const Timer& left, const Timer& right)
-		{
-			return left.expiry_time > right.expiry_time;
-		}
-	};
+	/**
+	 * Returns number of tick of duration.
+	 * @param round_up Rounds up to next tick if duration is not at boundary of tick.
+	 */
+	static std::uint64_t to_tick(lights::PreciseTime duration, bool round_up);
 
-	std::vector<Timer> m_timer_queue;
-	int m_next_id = 1;
+	lights::PreciseTime m_start_time;
+	TimingWheel<Timer> m_timer_wheel;
 };
 
 } // namespace spaceless
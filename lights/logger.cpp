@@ -7,6 +7,7 @@
 #include "logger.h"
 
 #include <memory>
+#include <algorithm>
 
 #include "precise_time.h"
 
@@ -50,10 +51,44 @@ void TextLogger::log(LogLevel level, const SourceLocation& location, const char*
 //}
 
 
+namespace details {
+
+/**
+ * Timestamp string of the last second. Formatting timestamp needs to convert to local time, so it's only
+ * formatted once per second in each thread.
+ */
+struct TimestampCache
+{
+	std::int64_t seconds = -1;
+	char text[32];
+	std::size_t length = 0;
+};
+
+static thread_local TimestampCache timestamp_cache;
+
+} // namespace details
+
+
 void TextLogger::generate_signature(LogLevel level)
 {
-	PreciseTime precise_time = current_precise_time();
-	m_writer << '[' << Timestamp(precise_time.seconds) << '.';
+	// Precision of coarse time is enough for log and it's much cheaper.
+	PreciseTime precise_time = current_coarse_precise_time();
+	m_writer << '[';
+
+	auto& cache = details::timestamp_cache;
+	if (cache.seconds != precise_time.seconds)
+	{
+		std::size_t begin = m_writer.size();
+		m_writer << Timestamp(precise_time.seconds);
+		cache.length = std::min(m_writer.size() - begin, sizeof(cache.text));
+		copy_array(cache.text, &m_write_target[begin], cache.length);
+		cache.seconds = precise_time.seconds;
+	}
+	else
+	{
+		m_writer.append(StringView(cache.text, cache.length));
+	}
+	m_writer << '.';
 
 	auto millis = precise_time.nanoseconds / 1000 / 1000;
 	m_writer << pad(static_cast<unsigned>(millis), '0', 3);
@@ -30,4 +30,43 @@ PreciseTime current_precise_time()
 #endif
 }
 
+
+PreciseTime current_coarse_precise_time()
+{
+#if LIGHTS_OS == LIGHTS_OS_LINUX
+	timespec ts;
+	clock_gettime(CLOCK_REALTIME_COARSE, &ts);
+	return PreciseTime { ts.tv_sec, ts.tv_nsec };
+#else
+	return current_precise_time();
+#endif
+}
+
+
+PreciseTime current_monotonic_time()
+{
+#if LIGHTS_OS == LIGHTS_OS_LINUX
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return PreciseTime { ts.tv_sec, ts.tv_nsec };
+#else
+	namespace chrono = std::chrono;
+	auto duration = chrono::steady_clock::now().time_since_epoch();
+	auto nanosecond = chrono::duration_cast<chrono::nanoseconds>(duration).count();
+	return PreciseTime { nanosecond / PreciseTime::NANOSECONDS_OF_SECOND, nanosecond % PreciseTime::NANOSECONDS_OF_SECOND };
+#endif
+}
+
+
+PreciseTime current_coarse_monotonic_time()
+{
+#if LIGHTS_OS == LIGHTS_OS_LINUX
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+	return PreciseTime { ts.tv_sec, ts.tv_nsec };
+#else
+	return current_monotonic_time();
+#endif
+}
+
 } // namespace lights
\ No newline at end of file
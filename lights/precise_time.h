@@ -123,10 +123,32 @@ inline bool operator>(const PreciseTime& left, const PreciseTime& right)
 
 /**
  * Returns the current time point.
+ * @note It's wall-clock time that can jump by adjusting of system time. Uses monotonic time to measure duration.
  */
 PreciseTime current_precise_time();
 
 
+/**
+ * Returns the current wall-clock time point with low precision (about several milliseconds).
+ * It's much cheaper than @c current_precise_time and is enough to display.
+ */
+PreciseTime current_coarse_precise_time();
+
+
+/**
+ * Returns the current monotonic time point that never jump by adjusting of system time.
+ * @note Starting point is unspecified, so it's only use to measure duration.
+ */
+PreciseTime current_monotonic_time();
+
+
+/**
+ * Returns the current monotonic time point with low precision (about several milliseconds).
+ * It's much cheaper than @c current_monotonic_time and is enough to schedule timer.
+ */
+PreciseTime current_coarse_monotonic_time();
+
+
 /**
  * Converts nanosecond to microsecond.
  */
@@ -175,6 +197,16 @@ inline std::int64_t millisecond_to_microsecond(std::int64_t millisecond)
 	return millisecond * 1000;
 }
 
+/**
+ * Converts precise time to microsecond.
+ */
+inline std::int64_t to_microsecond(const PreciseTime& time)
+{
+	const std::int64_t MICROSECONDS_OF_SECOND = 1000000;
+	return time.seconds * MICROSECONDS_OF_SECOND + nanosecond_to_microsecond(time.nanoseconds);
+}
+
+
 /**
  * Puts precise time to format sink.
  */
@@ -33,6 +33,11 @@ public:
 		{
 			m_cmd_list.insert(std::make_pair(pair.second, pair.first));
 		}
+
+		for (auto& pair: default_command_priority_map)
+		{
+			m_priority_list[pair.first] = to_command_priority(pair.second);
+		}
 	}
 
 	/**
@@ -91,9 +96,32 @@ public:
 		return *cmd;
 	}
 
+	/**
+	 * Gets priority.
+	 * @note Returns normal priority if cannot find it.
+	 */
+	CommandPriority get_priority(int cmd)
+	{
+		auto itr = m_priority_list.find(cmd);
+		if (itr == m_priority_list.end())
+		{
+			return CommandPriority::NORMAL;
+		}
+		return itr->second;
+	}
+
+	/**
+	 * Sets priority.
+	 */
+	void set_priority(int cmd, CommandPriority priority)
+	{
+		m_priority_list[cmd] = priority;
+	}
+
 private:
 	std::map<int, std::string> m_name_list;
 	std::map<std::string, int> m_cmd_list;
+	std::map<int, CommandPriority> m_priority_list;
 };
 
 } // namespace details
@@ -129,5 +157,35 @@ int get_command(const Message& msg)
 	return get_command(get_message_name(msg));
 }
 
+CommandPriority get_command_priority(int cmd)
+{
+	return details::CommandTableImpl::instance()->get_priority(cmd);
+}
+
+void set_command_priority(int cmd, CommandPriority priority)
+{
+	details::CommandTableImpl::instance()->set_priority(cmd, priority);
+}
+
+CommandPriority to_command_priority(const std::string& name)
+{
+	if (name == "high")
+	{
+		return CommandPriority::HIGH;
+	}
+	else if (name == "normal")
+	{
+		return CommandPriority::NORMAL;
+	}
+	else if (name == "low")
+	{
+		return CommandPriority::LOW;
+	}
+	else
+	{
+		SPACELESS_THROW(ERR_PROTOCOL_PRIORITY_NOT_EXIST);
+	}
+}
+
 } // namespace protocol
 } // namespace spaceless
@@ -7,6 +7,8 @@
 #pragma once
 
 #include <string>
+#include <foundation/basics.h>
+
 #include "message_declare.h"
 
 namespace spaceless {
@@ -48,5 +50,23 @@ const int* find_command(const Message& msg);
  */
 int get_command(const Message& msg);
 
+/**
+ * Gets priority of command. Default priority is defined in command.txt.
+ * @note Returns normal priority if cannot find it.
+ */
+CommandPriority get_command_priority(int cmd);
+
+/**
+ * Sets priority of command.
+ * @note Must set before start scheduler, because it's not thread safe.
+ */
+void set_command_priority(int cmd, CommandPriority priority);
+
+/**
+ * Converts priority name to priority. Valid name is "high", "normal" and "low".
+ * @throw Throws exception if name is invalid.
+ */
+CommandPriority to_command_priority(const std::string& name);
+
 } // namespace protocol
 } // namespace spaceless
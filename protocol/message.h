@@ -7,7 +7,14 @@
 
 #pragma once
 
+#include <vector>
+#include <memory>
+#include <cstdint>
 #include <google/protobuf/message.h>
+#include <google/protobuf/wire_format_lite.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl.h>
+#include <lights/sequence.h>
 
 
 namespace spaceless {
@@ -28,7 +35,33 @@ inline const std::string& get_message_name(const Message& msg)
  */
 inline int get_message_size(const Message& msg)
 {
-	return msg.ByteSize();
+	return static_cast<int>(msg.ByteSizeLong());
+}
+
+/**
+ * Gets length of tag and length prefix of bytes field.
+ */
+inline int get_bytes_field_header_size(int field_number, std::size_t length)
+{
+	using google::protobuf::internal::WireFormatLite;
+	using google::protobuf::io::CodedOutputStream;
+	auto tag = WireFormatLite::MakeTag(field_number, WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+	return static_cast<int>(CodedOutputStream::VarintSize32(tag) +
+							CodedOutputStream::VarintSize32(static_cast<std::uint32_t>(length)));
+}
+
+/**
+ * Writes tag and length prefix of bytes field. So field value can be place after it without copy into message.
+ * @note Sequence must have enough space that get by @c get_bytes_field_header_size.
+ */
+inline void write_bytes_field_header(int field_number, std::size_t length, lights::Sequence sequence)
+{
+	using google::protobuf::internal::WireFormatLite;
+	using google::protobuf::io::CodedOutputStream;
+	auto tag = WireFormatLite::MakeTag(field_number, WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+	auto target = static_cast<google::protobuf::uint8*>(sequence.data());
+	target = CodedOutputStream::WriteVarint32ToArray(tag, target);
+	CodedOutputStream::WriteVarint32ToArray(static_cast<std::uint32_t>(length), target);
 }
 
 /**
@@ -49,5 +82,80 @@ inline bool parse_to_sequence(const Message& msg, lights::Sequence sequence)
 	return msg.SerializeToArray(sequence.data(), static_cast<int>(sequence.length()));
 }
 
+/**
+ * Output stream that write to a list of sequence one by one.
+ */
+class SequenceListOutputStream: public google::protobuf::io::ZeroCopyOutputStream
+{
+public:
+	explicit SequenceListOutputStream(const std::vector<lights::Sequence>& sequence_list) :
+		m_sequence_list(sequence_list),
+		m_index(0),
+		m_byte_count(0)
+	{}
+
+	bool Next(void** data, int* size) override
+	{
+		if (m_index >= m_sequence_list.size())
+		{
+			return false;
+		}
+
+		lights::Sequence sequence = m_sequence_list[m_index];
+		*data = sequence.data();
+		*size = static_cast<int>(sequence.length());
+		m_byte_count += *size;
+		++m_index;
+		return true;
+	}
+
+	void BackUp(int count) override
+	{
+		m_byte_count -= count;
+	}
+
+	std::int64_t ByteCount() const override
+	{
+		return m_byte_count;
+	}
+
+private:
+	const std::vector<lights::Sequence>& m_sequence_list;
+	std::size_t m_index;
+	std::int64_t m_byte_count;
+};
+
+
+/**
+ * Parses sequence list to message. Uses to parse content that is not contiguous.
+ * @return Return is success or failure.
+ */
+inline bool parse_to_message(const std::vector<lights::SequenceView>& sequence_list, Message& msg)
+{
+	using google::protobuf::io::ArrayInputStream;
+	using google::protobuf::io::ZeroCopyInputStream;
+
+	std::vector<std::unique_ptr<ArrayInputStream>> stream_holder;
+	std::vector<ZeroCopyInputStream*> stream_list;
+	for (auto& sequence : sequence_list)
+	{
+		stream_holder.emplace_back(new ArrayInputStream(sequence.data(), static_cast<int>(sequence.length())));
+		stream_list.push_back(stream_holder.back().get());
+	}
+
+	google::protobuf::io::ConcatenatingInputStream input(stream_list.data(), static_cast<int>(stream_list.size()));
+	return msg.ParseFromZeroCopyStream(&input);
+}
+
+/**
+ * Parses message to sequence list. Uses to parse message to content that is not contiguous.
+ * @return Return is success or failure.
+ */
+inline bool parse_to_sequence(const Message& msg, const std::vector<lights::Sequence>& sequence_list)
+{
+	SequenceListOutputStream output(sequence_list);
+	return msg.SerializeToZeroCopyStream(&output);
+}
+
 } // namespace protocol
 } // namespace spaceless
@@ -20,6 +20,7 @@
 // @@protoc_insertion_point(includes)
 
 namespace protobuf_protocol_2eproto {
+extern PROTOBUF_INTERNAL_EXPORT_protobuf_protocol_2eproto ::google::protobuf::internal::SCCInfo<0> scc_info_BatchEntry;
 extern PROTOBUF_INTERNAL_EXPORT_protobuf_protocol_2eproto ::google::protobuf::internal::SCCInfo<0> scc_info_ErrorInfo;
 extern PROTOBUF_INTERNAL_EXPORT_protobuf_protocol_2eproto ::google::protobuf::internal::SCCInfo<0> scc_info_File;
 extern PROTOBUF_INTERNAL_EXPORT_protobuf_protocol_2eproto ::google::protobuf::internal::SCCInfo<0> scc_info_SharingGroup;
@@ -262,6 +263,21 @@ class RspRemovePathDefaultTypeInternal {
   ::google::protobuf::internal::ExplicitlyConstructed<RspRemovePath>
       _instance;
 } _RspRemovePath_default_instance_;
+class BatchEntryDefaultTypeInternal {
+ public:
+  ::google::protobuf::internal::ExplicitlyConstructed<BatchEntry>
+      _instance;
+} _BatchEntry_default_instance_;
+class ReqBatchDefaultTypeInternal {
+ public:
+  ::google::protobuf::internal::ExplicitlyConstructed<ReqBatch>
+      _instance;
+} _ReqBatch_default_instance_;
+class RspBatchDefaultTypeInternal {
+ public:
+  ::google::protobuf::internal::ExplicitlyConstructed<RspBatch>
+      _instance;
+} _RspBatch_default_instance_;
 }  // namespace protocol
 }  // namespace spaceless
 namespace protobuf_protocol_2eproto {
@@ -948,6 +964,51 @@ static void InitDefaultsRspRemovePath() {
     {{ATOMIC_VAR_INIT(::google::protobuf::internal::SCCInfoBase::kUninitialized), 1, InitDefaultsRspRemovePath}, {
       &protobuf_protocol_2eproto::scc_info_ErrorInfo.base,}};
 
+static void InitDefaultsBatchEntry() {
+  GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+  {
+    void* ptr = &::spaceless::protocol::_BatchEntry_default_instance_;
+    new (ptr) ::spaceless::protocol::BatchEntry();
+    ::google::protobuf::internal::OnShutdownDestroyMessage(ptr);
+  }
+  ::spaceless::protocol::BatchEntry::InitAsDefaultInstance();
+}
+
+::google::protobuf::internal::SCCInfo<0> scc_info_BatchEntry =
+    {{ATOMIC_VAR_INIT(::google::protobuf::internal::SCCInfoBase::kUninitialized), 0, InitDefaultsBatchEntry}, {}};
+
+static void InitDefaultsReqBatch() {
+  GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+  {
+    void* ptr = &::spaceless::protocol::_ReqBatch_default_instance_;
+    new (ptr) ::spaceless::protocol::ReqBatch();
+    ::google::protobuf::internal::OnShutdownDestroyMessage(ptr);
+  }
+  ::spaceless::protocol::ReqBatch::InitAsDefaultInstance();
+}
+
+::google::protobuf::internal::SCCInfo<1> scc_info_ReqBatch =
+    {{ATOMIC_VAR_INIT(::google::protobuf::internal::SCCInfoBase::kUninitialized), 1, InitDefaultsReqBatch}, {
+      &protobuf_protocol_2eproto::scc_info_BatchEntry.base,}};
+
+static void InitDefaultsRspBatch() {
+  GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+  {
+    void* ptr = &::spaceless::protocol::_RspBatch_default_instance_;
+    new (ptr) ::spaceless::protocol::RspBatch();
+    ::google::protobuf::internal::OnShutdownDestroyMessage(ptr);
+  }
+  ::spaceless::protocol::RspBatch::InitAsDefaultInstance();
+}
+
+::google::protobuf::internal::SCCInfo<2> scc_info_RspBatch =
+    {{ATOMIC_VAR_INIT(::google::protobuf::internal::SCCInfoBase::kUninitialized), 2, InitDefaultsRspBatch}, {
+      &protobuf_protocol_2eproto::scc_info_ErrorInfo.base,
+      &protobuf_protocol_2eproto::scc_info_BatchEntry.base,}};
+
 void InitDefaults() {
   ::google::protobuf::internal::InitSCC(&scc_info_ErrorInfo.base);
   ::google::protobuf::internal::InitSCC(&scc_info_RspError.base);
@@ -996,9 +1057,12 @@ void InitDefaults() {
   ::google::protobuf::internal::InitSCC(&scc_info_RspCreatePath.base);
   ::google::protobuf::internal::InitSCC(&scc_info_ReqRemovePath.base);
   ::google::protobuf::internal::InitSCC(&scc_info_RspRemovePath.base);
+  ::google::protobuf::internal::InitSCC(&scc_info_BatchEntry.base);
+  ::google::protobuf::internal::InitSCC(&scc_info_ReqBatch.base);
+  ::google::protobuf::internal::InitSCC(&scc_info_RspBatch.base);
 }
 
-::google::protobuf::Metadata file_level_metadata[47];
+::google::protobuf::Metadata file_level_metadata[50];
 const ::google::protobuf::EnumDescriptor* file_level_enum_descriptors[2];
 
 const ::google::protobuf::uint32 TableStruct::offsets[] GOOGLE_PROTOBUF_ATTRIBUTE_SECTION_VARIABLE(protodesc_cold) = {
@@ -1229,6 +1293,7 @@ const ::google::protobuf::uint32 TableStruct::offsets[] GOOGLE_PROTOBUF_ATTRIBUT
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::spaceless::protocol::RspPutFileSession, error_),
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::spaceless::protocol::RspPutFileSession, session_id_),
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::spaceless::protocol::RspPutFileSession, next_fragment_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::spaceless::protocol::RspPutFileSession, window_size_),
   ~0u,  // no _has_bits_
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::spaceless::protocol::ReqNodePutFileSession, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -1331,6 +1396,26 @@ const ::google::protobuf::uint32 TableStruct::offsets[] GOOGLE_PROTOBUF_ATTRIBUT
   ~0u,  // no _oneof_case_
   ~0u,  // no _weak_field_map_
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::spaceless::protocol::RspRemovePath, error_),
+  ~0u,  // no _has_bits_
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::spaceless::protocol::BatchEntry, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::spaceless::protocol::BatchEntry, command_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::spaceless::protocol::BatchEntry, content_),
+  ~0u,  // no _has_bits_
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::spaceless::protocol::ReqBatch, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::spaceless::protocol::ReqBatch, entry_list_),
+  ~0u,  // no _has_bits_
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::spaceless::protocol::RspBatch, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::spaceless::protocol::RspBatch, error_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::spaceless::protocol::RspBatch, entry_list_),
 };
 static const ::google::protobuf::internal::MigrationSchema schemas[] GOOGLE_PROTOBUF_ATTRIBUTE_SECTION_VARIABLE(protodesc_cold) = {
   { 0, -1, sizeof(::spaceless::protocol::ErrorInfo)},
@@ -1366,20 +1451,23 @@ static const ::google::protobuf::internal::MigrationSchema schemas[] GOOGLE_PROT
   { 204, -1, sizeof(::spaceless::protocol::RspListFile)},
   { 211, -1, sizeof(::spaceless::protocol::ReqPutFileSession)},
   { 219, -1, sizeof(::spaceless::protocol::RspPutFileSession)},
-  { 227, -1, sizeof(::spaceless::protocol::ReqNodePutFileSession)},
-  { 234, -1, sizeof(::spaceless::protocol::RspNodePutFileSession)},
-  { 241, -1, sizeof(::spaceless::protocol::ReqPutFile)},
-  { 249, -1, sizeof(::spaceless::protocol::RspPutFile)},
-  { 257, -1, sizeof(::spaceless::protocol::ReqGetFileSession)},
-  { 264, -1, sizeof(::spaceless::protocol::RspGetFileSession)},
-  { 272, -1, sizeof(::spaceless::protocol::ReqNodeGetFileSession)},
-  { 278, -1, sizeof(::spaceless::protocol::RspNodeGetFileSession)},
-  { 286, -1, sizeof(::spaceless::protocol::ReqGetFile)},
-  { 293, -1, sizeof(::spaceless::protocol::RspGetFile)},
-  { 302, -1, sizeof(::spaceless::protocol::ReqCreatePath)},
-  { 309, -1, sizeof(::spaceless::protocol::RspCreatePath)},
-  { 315, -1, sizeof(::spaceless::protocol::ReqRemovePath)},
-  { 323, -1, sizeof(::spaceless::protocol::RspRemovePath)},
+  { 228, -1, sizeof(::spaceless::protocol::ReqNodePutFileSession)},
+  { 235, -1, sizeof(::spaceless::protocol::RspNodePutFileSession)},
+  { 242, -1, sizeof(::spaceless::protocol::ReqPutFile)},
+  { 250, -1, sizeof(::spaceless::protocol::RspPutFile)},
+  { 258, -1, sizeof(::spaceless::protocol::ReqGetFileSession)},
+  { 265, -1, sizeof(::spaceless::protocol::RspGetFileSession)},
+  { 273, -1, sizeof(::spaceless::protocol::ReqNodeGetFileSession)},
+  { 279, -1, sizeof(::spaceless::protocol::RspNodeGetFileSession)},
+  { 287, -1, sizeof(::spaceless::protocol::ReqGetFile)},
+  { 294, -1, sizeof(::spaceless::protocol::RspGetFile)},
+  { 303, -1, sizeof(::spaceless::protocol::ReqCreatePath)},
+  { 310, -1, sizeof(::spaceless::protocol::RspCreatePath)},
+  { 316, -1, sizeof(::spaceless::protocol::ReqRemovePath)},
+  { 324, -1, sizeof(::spaceless::protocol::RspRemovePath)},
+  { 330, -1, sizeof(::spaceless::protocol::BatchEntry)},
+  { 337, -1, sizeof(::spaceless::protocol::ReqBatch)},
+  { 343, -1, sizeof(::spaceless::protocol::RspBatch)},
 };
 
 static ::google::protobuf::Message const * const file_default_instances[] = {
@@ -1430,6 +1518,9 @@ static ::google::protobuf::Message const * const file_default_instances[] = {
   reinterpret_cast<const ::google::protobuf::Message*>(&::spaceless::protocol::_RspCreatePath_default_instance_),
   reinterpret_cast<const ::google::protobuf::Message*>(&::spaceless::protocol::_ReqRemovePath_default_instance_),
   reinterpret_cast<const ::google::protobuf::Message*>(&::spaceless::protocol::_RspRemovePath_default_instance_),
+  reinterpret_cast<const ::google::protobuf::Message*>(&::spaceless::protocol::_BatchEntry_default_instance_),
+  reinterpret_cast<const ::google::protobuf::Message*>(&::spaceless::protocol::_ReqBatch_default_instance_),
+  reinterpret_cast<const ::google::protobuf::Message*>(&::spaceless::protocol::_RspBatch_default_instance_),
 };
 
 void protobuf_AssignDescriptors() {
@@ -1447,7 +1538,7 @@ void protobuf_AssignDescriptorsOnce() {
 void protobuf_RegisterTypes(const ::std::string&) GOOGLE_PROTOBUF_ATTRIBUTE_COLD;
 void protobuf_RegisterTypes(const ::std::string&) {
   protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::internal::RegisterAllTypes(file_level_metadata, 47);
+  ::google::protobuf::internal::RegisterAllTypes(file_level_metadata, 50);
 }
 
 void AddDescriptorsImpl() {
@@ -1506,44 +1597,50 @@ void AddDescriptorsImpl() {
       "orInfo\022+\n\tfile_list\030\002 \003(\0132\030.spaceless.pr"
       "otocol.File\"N\n\021ReqPutFileSession\022\020\n\010grou"
       "p_id\030\001 \001(\005\022\021\n\tfile_path\030\002 \001(\t\022\024\n\014max_fra"
-      "gment\030\003 \001(\005\"l\n\021RspPutFileSession\022,\n\005erro"
-      "r\030\001 \001(\0132\035.spaceless.protocol.ErrorInfo\022\022"
-      "\n\nsession_id\030\002 \001(\005\022\025\n\rnext_fragment\030\003 \001("
-      "\005\"@\n\025ReqNodePutFileSession\022\021\n\tfile_path\030"
-      "\002 \001(\t\022\024\n\014max_fragment\030\003 \001(\005\"Y\n\025RspNodePu"
-      "tFileSession\022,\n\005error\030\001 \001(\0132\035.spaceless."
-      "protocol.ErrorInfo\022\022\n\nsession_id\030\002 \001(\005\"R"
-      "\n\nReqPutFile\022\022\n\nsession_id\030\001 \001(\005\022\026\n\016frag"
-      "ment_index\030\002 \001(\005\022\030\n\020fragment_content\030\003 \001"
-      "(\014\"f\n\nRspPutFile\022,\n\005error\030\001 \001(\0132\035.spacel"
-      "ess.protocol.ErrorInfo\022\022\n\nsession_id\030\002 \001"
-      "(\005\022\026\n\016fragment_index\030\003 \001(\005\"8\n\021ReqGetFile"
-      "Session\022\020\n\010group_id\030\001 \001(\005\022\021\n\tfile_path\030\002"
-      " \001(\t\"k\n\021RspGetFileSession\022,\n\005error\030\001 \001(\013"
-      "2\035.spaceless.protocol.ErrorInfo\022\022\n\nsessi"
-      "on_id\030\002 \001(\005\022\024\n\014max_fragment\030\003 \001(\005\"*\n\025Req"
-      "NodeGetFileSession\022\021\n\tfile_path\030\002 \001(\t\"o\n"
-      "\025RspNodeGetFileSession\022,\n\005error\030\001 \001(\0132\035."
-      "spaceless.protocol.ErrorInfo\022\022\n\nsession_"
-      "id\030\002 \001(\005\022\024\n\014max_fragment\030\003 \001(\005\"8\n\nReqGet"
-      "File\022\022\n\nsession_id\030\001 \001(\005\022\026\n\016fragment_ind"
-      "ex\030\002 \001(\005\"\200\001\n\nRspGetFile\022,\n\005error\030\001 \001(\0132\035"
-      ".spaceless.protocol.ErrorInfo\022\022\n\nsession"
-      "_id\030\002 \001(\005\022\026\n\016fragment_index\030\003 \001(\005\022\030\n\020fra"
-      "gment_content\030\004 \001(\014\"/\n\rReqCreatePath\022\020\n\010"
-      "group_id\030\001 \001(\005\022\014\n\004path\030\002 \001(\t\"=\n\rRspCreat"
+      "gment\030\003 \001(\005\"\201\001\n\021RspPutFileSession\022,\n\005err"
+      "or\030\001 \001(\0132\035.spaceless.protocol.ErrorInfo\022"
+      "\022\n\nsession_id\030\002 \001(\005\022\025\n\rnext_fragment\030\003 \001"
+      "(\005\022\023\n\013window_size\030\004 \001(\005\"@\n\025ReqNodePutFil"
+      "eSession\022\021\n\tfile_path\030\002 \001(\t\022\024\n\014max_fragm"
+      "ent\030\003 \001(\005\"Y\n\025RspNodePutFileSession\022,\n\005er"
+      "ror\030\001 \001(\0132\035.spaceless.protocol.ErrorInfo"
+      "\022\022\n\nsession_id\030\002 \001(\005\"R\n\nReqPutFile\022\022\n\nse"
+      "ssion_id\030\001 \001(\005\022\026\n\016fragment_index\030\002 \001(\005\022\030"
+      "\n\020fragment_content\030\003 \001(\014\"f\n\nRspPutFile\022,"
+      "\n\005error\030\001 \001(\0132\035.spaceless.protocol.Error"
+      "Info\022\022\n\nsession_id\030\002 \001(\005\022\026\n\016fragment_ind"
+      "ex\030\003 \001(\005\"8\n\021ReqGetFileSession\022\020\n\010group_i"
+      "d\030\001 \001(\005\022\021\n\tfile_path\030\002 \001(\t\"k\n\021RspGetFile"
+      "Session\022,\n\005error\030\001 \001(\0132\035.spaceless.proto"
+      "col.ErrorInfo\022\022\n\nsession_id\030\002 \001(\005\022\024\n\014max"
+      "_fragment\030\003 \001(\005\"*\n\025ReqNodeGetFileSession"
+      "\022\021\n\tfile_path\030\002 \001(\t\"o\n\025RspNodeGetFileSes"
+      "sion\022,\n\005error\030\001 \001(\0132\035.spaceless.protocol"
+      ".ErrorInfo\022\022\n\nsession_id\030\002 \001(\005\022\024\n\014max_fr"
+      "agment\030\003 \001(\005\"8\n\nReqGetFile\022\022\n\nsession_id"
+      "\030\001 \001(\005\022\026\n\016fragment_index\030\002 \001(\005\"\200\001\n\nRspGe"
+      "tFile\022,\n\005error\030\001 \001(\0132\035.spaceless.protoco"
+      "l.ErrorInfo\022\022\n\nsession_id\030\002 \001(\005\022\026\n\016fragm"
+      "ent_index\030\003 \001(\005\022\030\n\020fragment_content\030\004 \001("
+      "\014\"/\n\rReqCreatePath\022\020\n\010group_id\030\001 \001(\005\022\014\n\004"
+      "path\030\002 \001(\t\"=\n\rRspCreatePath\022,\n\005error\030\001 \001"
+      "(\0132\035.spaceless.protocol.ErrorInfo\"I\n\rReq"
+      "RemovePath\022\020\n\010group_id\030\001 \001(\005\022\014\n\004path\030\002 \001"
+      "(\t\022\030\n\020force_remove_all\030\003 \001(\010\"=\n\rRspRemov"
       "ePath\022,\n\005error\030\001 \001(\0132\035.spaceless.protoco"
-      "l.ErrorInfo\"I\n\rReqRemovePath\022\020\n\010group_id"
-      "\030\001 \001(\005\022\014\n\004path\030\002 \001(\t\022\030\n\020force_remove_all"
-      "\030\003 \001(\010\"=\n\rRspRemovePath\022,\n\005error\030\001 \001(\0132\035"
-      ".spaceless.protocol.ErrorInfo*N\n\021Miscell"
-      "aneousType\022\031\n\025INVALID_MISCELLANEOUS\020\000\022\036\n"
-      "\030MAX_FRAGMENT_CONTENT_LEN\020\320\206\003*+\n\010FileTyp"
-      "e\022\020\n\014GENERAL_FILE\020\000\022\r\n\tDIRECTORY\020\001b\006prot"
-      "o3"
+      "l.ErrorInfo\".\n\nBatchEntry\022\017\n\007command\030\001 \001"
+      "(\005\022\017\n\007content\030\002 \001(\014\">\n\010ReqBatch\0222\n\nentry"
+      "_list\030\001 \003(\0132\036.spaceless.protocol.BatchEn"
+      "try\"l\n\010RspBatch\022,\n\005error\030\001 \001(\0132\035.spacele"
+      "ss.protocol.ErrorInfo\0222\n\nentry_list\030\002 \003("
+      "\0132\036.spaceless.protocol.BatchEntry*O\n\021Mis"
+      "cellaneousType\022\031\n\025INVALID_MISCELLANEOUS\020"
+      "\000\022\037\n\030MAX_FRAGMENT_CONTENT_LEN\020\200\200\200\002*+\n\010Fi"
+      "leType\022\020\n\014GENERAL_FILE\020\000\022\r\n\tDIRECTORY\020\001b"
+      "\006proto3"
   };
   ::google::protobuf::DescriptorPool::InternalAddGeneratedFile(
-      descriptor, 3482);
+      descriptor, 3727);
   ::google::protobuf::MessageFactory::InternalRegisterGeneratedFile(
     "protocol.proto", &protobuf_RegisterTypes);
 }
@@ -1568,7 +1665,7 @@ const ::google::protobuf::EnumDescriptor* MiscellaneousType_descriptor() {
 bool MiscellaneousType_IsValid(int value) {
   switch (value) {
     case 0:
-    case 50000:
+    case 4194304:
       return true;
     default:
       return false;
@@ -10279,6 +10376,7 @@ void RspPutFileSession::InitAsDefaultInstance() {
 const int RspPutFileSession::kErrorFieldNumber;
 const int RspPutFileSession::kSessionIdFieldNumber;
 const int RspPutFileSession::kNextFragmentFieldNumber;
+const int RspPutFileSession::kWindowSizeFieldNumber;
 #endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
 
 RspPutFileSession::RspPutFileSession()
@@ -10298,15 +10396,15 @@ RspPutFileSession::RspPutFileSession(const RspPutFileSession& from)
     error_ = NULL;
   }
   ::memcpy(&session_id_, &from.session_id_,
-    static_cast<size_t>(reinterpret_cast<char*>(&next_fragment_) -
-    reinterpret_cast<char*>(&session_id_)) + sizeof(next_fragment_));
+    static_cast<size_t>(reinterpret_cast<char*>(&window_size_) -
+    reinterpret_cast<char*>(&session_id_)) + sizeof(window_size_));
   // @@protoc_insertion_point(copy_constructor:spaceless.protocol.RspPutFileSession)
 }
 
 void RspPutFileSession::SharedCtor() {
   ::memset(&error_, 0, static_cast<size_t>(
-      reinterpret_cast<char*>(&next_fragment_) -
-      reinterpret_cast<char*>(&error_)) + sizeof(next_fragment_));
+      reinterpret_cast<char*>(&window_size_) -
+      reinterpret_cast<char*>(&error_)) + sizeof(window_size_));
 }
 
 RspPutFileSession::~RspPutFileSession() {
@@ -10343,8 +10441,8 @@ void RspPutFileSession::Clear() {
   }
   error_ = NULL;
   ::memset(&session_id_, 0, static_cast<size_t>(
-      reinterpret_cast<char*>(&next_fragment_) -
-      reinterpret_cast<char*>(&session_id_)) + sizeof(next_fragment_));
+      reinterpret_cast<char*>(&window_size_) -
+      reinterpret_cast<char*>(&session_id_)) + sizeof(window_size_));
   _internal_metadata_.Clear();
 }
 
@@ -10398,6 +10496,20 @@ bool RspPutFileSession::MergePartialFromCodedStream(
         break;
       }
 
+      // int32 window_size = 4;
+      case 4: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(32u /* 32 & 0xFF */)) {
+
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::int32, ::google::protobuf::internal::WireFormatLite::TYPE_INT32>(
+                 input, &window_size_)));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
       default: {
       handle_unusual:
         if (tag == 0) {
@@ -10440,6 +10552,11 @@ void RspPutFileSession::SerializeWithCachedSizes(
     ::google::protobuf::internal::WireFormatLite::WriteInt32(3, this->next_fragment(), output);
   }
 
+  // int32 window_size = 4;
+  if (this->window_size() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteInt32(4, this->window_size(), output);
+  }
+
   if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
     ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
         (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), output);
@@ -10471,6 +10588,11 @@ void RspPutFileSession::SerializeWithCachedSizes(
     target = ::google::protobuf::internal::WireFormatLite::WriteInt32ToArray(3, this->next_fragment(), target);
   }
 
+  // int32 window_size = 4;
+  if (this->window_size() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteInt32ToArray(4, this->window_size(), target);
+  }
+
   if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
     target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
         (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), target);
@@ -10509,6 +10631,13 @@ size_t RspPutFileSession::ByteSizeLong() const {
         this->next_fragment());
   }
 
+  // int32 window_size = 4;
+  if (this->window_size() != 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::Int32Size(
+        this->window_size());
+  }
+
   int cached_size = ::google::protobuf::internal::ToCachedSize(total_size);
   SetCachedSize(cached_size);
   return total_size;
@@ -10545,6 +10674,9 @@ void RspPutFileSession::MergeFrom(const RspPutFileSession& from) {
   if (from.next_fragment() != 0) {
     set_next_fragment(from.next_fragment());
   }
+  if (from.window_size() != 0) {
+    set_window_size(from.window_size());
+  }
 }
 
 void RspPutFileSession::CopyFrom(const ::google::protobuf::Message& from) {
@@ -10574,6 +10706,7 @@ void RspPutFileSession::InternalSwap(RspPutFileSession* other) {
   swap(error_, other->error_);
   swap(session_id_, other->session_id_);
   swap(next_fragment_, other->next_fragment_);
+  swap(window_size_, other->window_size_);
   _internal_metadata_.Swap(&other->_internal_metadata_);
 }
 
@@ -14609,67 +14742,844 @@ void RspRemovePath::InternalSwap(RspRemovePath* other) {
 }
 
 
-// @@protoc_insertion_point(namespace_scope)
-}  // namespace protocol
-}  // namespace spaceless
-namespace google {
-namespace protobuf {
-template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::ErrorInfo* Arena::CreateMaybeMessage< ::spaceless::protocol::ErrorInfo >(Arena* arena) {
-  return Arena::CreateInternal< ::spaceless::protocol::ErrorInfo >(arena);
-}
-template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::RspError* Arena::CreateMaybeMessage< ::spaceless::protocol::RspError >(Arena* arena) {
-  return Arena::CreateInternal< ::spaceless::protocol::RspError >(arena);
+// ===================================================================
+
+void BatchEntry::InitAsDefaultInstance() {
 }
-template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::ReqPing* Arena::CreateMaybeMessage< ::spaceless::protocol::ReqPing >(Arena* arena) {
-  return Arena::CreateInternal< ::spaceless::protocol::ReqPing >(arena);
+#if !defined(_MSC_VER) || _MSC_VER >= 1900
+const int BatchEntry::kCommandFieldNumber;
+const int BatchEntry::kContentFieldNumber;
+#endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
+
+BatchEntry::BatchEntry()
+  : ::google::protobuf::Message(), _internal_metadata_(NULL) {
+  ::google::protobuf::internal::InitSCC(
+      &protobuf_protocol_2eproto::scc_info_BatchEntry.base);
+  SharedCtor();
+  // @@protoc_insertion_point(constructor:spaceless.protocol.BatchEntry)
 }
-template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::RspPing* Arena::CreateMaybeMessage< ::spaceless::protocol::RspPing >(Arena* arena) {
-  return Arena::CreateInternal< ::spaceless::protocol::RspPing >(arena);
+BatchEntry::BatchEntry(const BatchEntry& from)
+  : ::google::protobuf::Message(),
+      _internal_metadata_(NULL) {
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  content_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  if (from.content().size() > 0) {
+    content_.AssignWithDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), from.content_);
+  }
+  command_ = from.command_;
+  // @@protoc_insertion_point(copy_constructor:spaceless.protocol.BatchEntry)
 }
-template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::User* Arena::CreateMaybeMessage< ::spaceless::protocol::User >(Arena* arena) {
-  return Arena::CreateInternal< ::spaceless::protocol::User >(arena);
+
+void BatchEntry::SharedCtor() {
+  content_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  command_ = 0;
 }
-template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::ReqRegisterUser* Arena::CreateMaybeMessage< ::spaceless::protocol::ReqRegisterUser >(Arena* arena) {
-  return Arena::CreateInternal< ::spaceless::protocol::ReqRegisterUser >(arena);
+
+BatchEntry::~BatchEntry() {
+  // @@protoc_insertion_point(destructor:spaceless.protocol.BatchEntry)
+  SharedDtor();
 }
-template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::RspRegisterUser* Arena::CreateMaybeMessage< ::spaceless::protocol::RspRegisterUser >(Arena* arena) {
-  return Arena::CreateInternal< ::spaceless::protocol::RspRegisterUser >(arena);
+
+void BatchEntry::SharedDtor() {
+  content_.DestroyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
 }
-template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::ReqLoginUser* Arena::CreateMaybeMessage< ::spaceless::protocol::ReqLoginUser >(Arena* arena) {
-  return Arena::CreateInternal< ::spaceless::protocol::ReqLoginUser >(arena);
+
+void BatchEntry::SetCachedSize(int size) const {
+  _cached_size_.Set(size);
 }
-template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::RspLoginUser* Arena::CreateMaybeMessage< ::spaceless::protocol::RspLoginUser >(Arena* arena) {
-  return Arena::CreateInternal< ::spaceless::protocol::RspLoginUser >(arena);
+const ::google::protobuf::Descriptor* BatchEntry::descriptor() {
+  ::protobuf_protocol_2eproto::protobuf_AssignDescriptorsOnce();
+  return ::protobuf_protocol_2eproto::file_level_metadata[kIndexInFileMessages].descriptor;
 }
-template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::ReqRemoveUser* Arena::CreateMaybeMessage< ::spaceless::protocol::ReqRemoveUser >(Arena* arena) {
-  return Arena::CreateInternal< ::spaceless::protocol::ReqRemoveUser >(arena);
+
+const BatchEntry& BatchEntry::default_instance() {
+  ::google::protobuf::internal::InitSCC(&protobuf_protocol_2eproto::scc_info_BatchEntry.base);
+  return *internal_default_instance();
 }
-template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::RspRemoveUser* Arena::CreateMaybeMessage< ::spaceless::protocol::RspRemoveUser >(Arena* arena) {
-  return Arena::CreateInternal< ::spaceless::protocol::RspRemoveUser >(arena);
+
+
+void BatchEntry::Clear() {
+// @@protoc_insertion_point(message_clear_start:spaceless.protocol.BatchEntry)
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  content_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  command_ = 0;
+  _internal_metadata_.Clear();
 }
-template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::ReqFindUser* Arena::CreateMaybeMessage< ::spaceless::protocol::ReqFindUser >(Arena* arena) {
-  return Arena::CreateInternal< ::spaceless::protocol::ReqFindUser >(arena);
+
+bool BatchEntry::MergePartialFromCodedStream(
+    ::google::protobuf::io::CodedInputStream* input) {
+#define DO_(EXPRESSION) if (!GOOGLE_PREDICT_TRUE(EXPRESSION)) goto failure
+  ::google::protobuf::uint32 tag;
+  // @@protoc_insertion_point(parse_start:spaceless.protocol.BatchEntry)
+  for (;;) {
+    ::std::pair<::google::protobuf::uint32, bool> p = input->ReadTagWithCutoffNoLastTag(127u);
+    tag = p.first;
+    if (!p.second) goto handle_unusual;
+    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+      // int32 command = 1;
+      case 1: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(8u /* 8 & 0xFF */)) {
+
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::int32, ::google::protobuf::internal::WireFormatLite::TYPE_INT32>(
+                 input, &command_)));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // bytes content = 2;
+      case 2: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(18u /* 18 & 0xFF */)) {
+          DO_(::google::protobuf::internal::WireFormatLite::ReadBytes(
+                input, this->mutable_content()));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      default: {
+      handle_unusual:
+        if (tag == 0) {
+          goto success;
+        }
+        DO_(::google::protobuf::internal::WireFormat::SkipField(
+              input, tag, _internal_metadata_.mutable_unknown_fields()));
+        break;
+      }
+    }
+  }
+success:
+  // @@protoc_insertion_point(parse_success:spaceless.protocol.BatchEntry)
+  return true;
+failure:
+  // @@protoc_insertion_point(parse_failure:spaceless.protocol.BatchEntry)
+  return false;
+#undef DO_
 }
-template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::RspFindUser* Arena::CreateMaybeMessage< ::spaceless::protocol::RspFindUser >(Arena* arena) {
-  return Arena::CreateInternal< ::spaceless::protocol::RspFindUser >(arena);
+
+void BatchEntry::SerializeWithCachedSizes(
+    ::google::protobuf::io::CodedOutputStream* output) const {
+  // @@protoc_insertion_point(serialize_start:spaceless.protocol.BatchEntry)
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // int32 command = 1;
+  if (this->command() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteInt32(1, this->command(), output);
+  }
+
+  // bytes content = 2;
+  if (this->content().size() > 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteBytesMaybeAliased(
+      2, this->content(), output);
+  }
+
+  if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
+    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
+        (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), output);
+  }
+  // @@protoc_insertion_point(serialize_end:spaceless.protocol.BatchEntry)
 }
-template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::SharingGroup* Arena::CreateMaybeMessage< ::spaceless::protocol::SharingGroup >(Arena* arena) {
-  return Arena::CreateInternal< ::spaceless::protocol::SharingGroup >(arena);
+
+::google::protobuf::uint8* BatchEntry::InternalSerializeWithCachedSizesToArray(
+    bool deterministic, ::google::protobuf::uint8* target) const {
+  (void)deterministic; // Unused
+  // @@protoc_insertion_point(serialize_to_array_start:spaceless.protocol.BatchEntry)
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // int32 command = 1;
+  if (this->command() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteInt32ToArray(1, this->command(), target);
+  }
+
+  // bytes content = 2;
+  if (this->content().size() > 0) {
+    target =
+      ::google::protobuf::internal::WireFormatLite::WriteBytesToArray(
+        2, this->content(), target);
+  }
+
+  if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
+    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
+        (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), target);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:spaceless.protocol.BatchEntry)
+  return target;
 }
-template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::ReqRegisterGroup* Arena::CreateMaybeMessage< ::spaceless::protocol::ReqRegisterGroup >(Arena* arena) {
-  return Arena::CreateInternal< ::spaceless::protocol::ReqRegisterGroup >(arena);
+
+size_t BatchEntry::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:spaceless.protocol.BatchEntry)
+  size_t total_size = 0;
+
+  if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
+    total_size +=
+      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
+        (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()));
+  }
+  // bytes content = 2;
+  if (this->content().size() > 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::BytesSize(
+        this->content());
+  }
+
+  // int32 command = 1;
+  if (this->command() != 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::Int32Size(
+        this->command());
+  }
+
+  int cached_size = ::google::protobuf::internal::ToCachedSize(total_size);
+  SetCachedSize(cached_size);
+  return total_size;
 }
-template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::RspRegisterGroup* Arena::CreateMaybeMessage< ::spaceless::protocol::RspRegisterGroup >(Arena* arena) {
-  return Arena::CreateInternal< ::spaceless::protocol::RspRegisterGroup >(arena);
+
+void BatchEntry::MergeFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:spaceless.protocol.BatchEntry)
+  GOOGLE_DCHECK_NE(&from, this);
+  const BatchEntry* source =
+      ::google::protobuf::internal::DynamicCastToGenerated<const BatchEntry>(
+          &from);
+  if (source == NULL) {
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:spaceless.protocol.BatchEntry)
+    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
+  } else {
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:spaceless.protocol.BatchEntry)
+    MergeFrom(*source);
+  }
 }
-template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::ReqRemoveGroup* Arena::CreateMaybeMessage< ::spaceless::protocol::ReqRemoveGroup >(Arena* arena) {
-  return Arena::CreateInternal< ::spaceless::protocol::ReqRemoveGroup >(arena);
+
+void BatchEntry::MergeFrom(const BatchEntry& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:spaceless.protocol.BatchEntry)
+  GOOGLE_DCHECK_NE(&from, this);
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  if (from.content().size() > 0) {
+
+    content_.AssignWithDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), from.content_);
+  }
+  if (from.command() != 0) {
+    set_command(from.command());
+  }
 }
-template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::RspRemoveGroup* Arena::CreateMaybeMessage< ::spaceless::protocol::RspRemoveGroup >(Arena* arena) {
-  return Arena::CreateInternal< ::spaceless::protocol::RspRemoveGroup >(arena);
+
+void BatchEntry::CopyFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:spaceless.protocol.BatchEntry)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
 }
-template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::ReqFindGroup* Arena::CreateMaybeMessage< ::spaceless::protocol::ReqFindGroup >(Arena* arena) {
-  return Arena::CreateInternal< ::spaceless::protocol::ReqFindGroup >(arena);
+
+void BatchEntry::CopyFrom(const BatchEntry& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:spaceless.protocol.BatchEntry)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool BatchEntry::IsInitialized() const {
+  return true;
+}
+
+void BatchEntry::Swap(BatchEntry* other) {
+  if (other == this) return;
+  InternalSwap(other);
+}
+void BatchEntry::InternalSwap(BatchEntry* other) {
+  using std::swap;
+  content_.Swap(&other->content_, &::google::protobuf::internal::GetEmptyStringAlreadyInited(),
+    GetArenaNoVirtual());
+  swap(command_, other->command_);
+  _internal_metadata_.Swap(&other->_internal_metadata_);
+}
+
+::google::protobuf::Metadata BatchEntry::GetMetadata() const {
+  protobuf_protocol_2eproto::protobuf_AssignDescriptorsOnce();
+  return ::protobuf_protocol_2eproto::file_level_metadata[kIndexInFileMessages];
+}
+
+
+// ===================================================================
+
+void ReqBatch::InitAsDefaultInstance() {
+}
+#if !defined(_MSC_VER) || _MSC_VER >= 1900
+const int ReqBatch::kEntryListFieldNumber;
+#endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
+
+ReqBatch::ReqBatch()
+  : ::google::protobuf::Message(), _internal_metadata_(NULL) {
+  ::google::protobuf::internal::InitSCC(
+      &protobuf_protocol_2eproto::scc_info_ReqBatch.base);
+  SharedCtor();
+  // @@protoc_insertion_point(constructor:spaceless.protocol.ReqBatch)
+}
+ReqBatch::ReqBatch(const ReqBatch& from)
+  : ::google::protobuf::Message(),
+      _internal_metadata_(NULL),
+      entry_list_(from.entry_list_) {
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  // @@protoc_insertion_point(copy_constructor:spaceless.protocol.ReqBatch)
+}
+
+void ReqBatch::SharedCtor() {
+}
+
+ReqBatch::~ReqBatch() {
+  // @@protoc_insertion_point(destructor:spaceless.protocol.ReqBatch)
+  SharedDtor();
+}
+
+void ReqBatch::SharedDtor() {
+}
+
+void ReqBatch::SetCachedSize(int size) const {
+  _cached_size_.Set(size);
+}
+const ::google::protobuf::Descriptor* ReqBatch::descriptor() {
+  ::protobuf_protocol_2eproto::protobuf_AssignDescriptorsOnce();
+  return ::protobuf_protocol_2eproto::file_level_metadata[kIndexInFileMessages].descriptor;
+}
+
+const ReqBatch& ReqBatch::default_instance() {
+  ::google::protobuf::internal::InitSCC(&protobuf_protocol_2eproto::scc_info_ReqBatch.base);
+  return *internal_default_instance();
+}
+
+
+void ReqBatch::Clear() {
+// @@protoc_insertion_point(message_clear_start:spaceless.protocol.ReqBatch)
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  entry_list_.Clear();
+  _internal_metadata_.Clear();
+}
+
+bool ReqBatch::MergePartialFromCodedStream(
+    ::google::protobuf::io::CodedInputStream* input) {
+#define DO_(EXPRESSION) if (!GOOGLE_PREDICT_TRUE(EXPRESSION)) goto failure
+  ::google::protobuf::uint32 tag;
+  // @@protoc_insertion_point(parse_start:spaceless.protocol.ReqBatch)
+  for (;;) {
+    ::std::pair<::google::protobuf::uint32, bool> p = input->ReadTagWithCutoffNoLastTag(127u);
+    tag = p.first;
+    if (!p.second) goto handle_unusual;
+    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+      // repeated .spaceless.protocol.BatchEntry entry_list = 1;
+      case 1: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(10u /* 10 & 0xFF */)) {
+          DO_(::google::protobuf::internal::WireFormatLite::ReadMessage(
+                input, add_entry_list()));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      default: {
+      handle_unusual:
+        if (tag == 0) {
+          goto success;
+        }
+        DO_(::google::protobuf::internal::WireFormat::SkipField(
+              input, tag, _internal_metadata_.mutable_unknown_fields()));
+        break;
+      }
+    }
+  }
+success:
+  // @@protoc_insertion_point(parse_success:spaceless.protocol.ReqBatch)
+  return true;
+failure:
+  // @@protoc_insertion_point(parse_failure:spaceless.protocol.ReqBatch)
+  return false;
+#undef DO_
+}
+
+void ReqBatch::SerializeWithCachedSizes(
+    ::google::protobuf::io::CodedOutputStream* output) const {
+  // @@protoc_insertion_point(serialize_start:spaceless.protocol.ReqBatch)
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // repeated .spaceless.protocol.BatchEntry entry_list = 1;
+  for (unsigned int i = 0,
+      n = static_cast<unsigned int>(this->entry_list_size()); i < n; i++) {
+    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
+      1,
+      this->entry_list(static_cast<int>(i)),
+      output);
+  }
+
+  if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
+    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
+        (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), output);
+  }
+  // @@protoc_insertion_point(serialize_end:spaceless.protocol.ReqBatch)
+}
+
+::google::protobuf::uint8* ReqBatch::InternalSerializeWithCachedSizesToArray(
+    bool deterministic, ::google::protobuf::uint8* target) const {
+  (void)deterministic; // Unused
+  // @@protoc_insertion_point(serialize_to_array_start:spaceless.protocol.ReqBatch)
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // repeated .spaceless.protocol.BatchEntry entry_list = 1;
+  for (unsigned int i = 0,
+      n = static_cast<unsigned int>(this->entry_list_size()); i < n; i++) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      InternalWriteMessageToArray(
+        1, this->entry_list(static_cast<int>(i)), deterministic, target);
+  }
+
+  if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
+    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
+        (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), target);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:spaceless.protocol.ReqBatch)
+  return target;
+}
+
+size_t ReqBatch::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:spaceless.protocol.ReqBatch)
+  size_t total_size = 0;
+
+  if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
+    total_size +=
+      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
+        (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()));
+  }
+  // repeated .spaceless.protocol.BatchEntry entry_list = 1;
+  {
+    unsigned int count = static_cast<unsigned int>(this->entry_list_size());
+    total_size += 1UL * count;
+    for (unsigned int i = 0; i < count; i++) {
+      total_size +=
+        ::google::protobuf::internal::WireFormatLite::MessageSize(
+          this->entry_list(static_cast<int>(i)));
+    }
+  }
+
+  int cached_size = ::google::protobuf::internal::ToCachedSize(total_size);
+  SetCachedSize(cached_size);
+  return total_size;
+}
+
+void ReqBatch::MergeFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:spaceless.protocol.ReqBatch)
+  GOOGLE_DCHECK_NE(&from, this);
+  const ReqBatch* source =
+      ::google::protobuf::internal::DynamicCastToGenerated<const ReqBatch>(
+          &from);
+  if (source == NULL) {
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:spaceless.protocol.ReqBatch)
+    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
+  } else {
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:spaceless.protocol.ReqBatch)
+    MergeFrom(*source);
+  }
+}
+
+void ReqBatch::MergeFrom(const ReqBatch& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:spaceless.protocol.ReqBatch)
+  GOOGLE_DCHECK_NE(&from, this);
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  entry_list_.MergeFrom(from.entry_list_);
+}
+
+void ReqBatch::CopyFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:spaceless.protocol.ReqBatch)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void ReqBatch::CopyFrom(const ReqBatch& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:spaceless.protocol.ReqBatch)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool ReqBatch::IsInitialized() const {
+  return true;
+}
+
+void ReqBatch::Swap(ReqBatch* other) {
+  if (other == this) return;
+  InternalSwap(other);
+}
+void ReqBatch::InternalSwap(ReqBatch* other) {
+  using std::swap;
+  CastToBase(&entry_list_)->InternalSwap(CastToBase(&other->entry_list_));
+  _internal_metadata_.Swap(&other->_internal_metadata_);
+}
+
+::google::protobuf::Metadata ReqBatch::GetMetadata() const {
+  protobuf_protocol_2eproto::protobuf_AssignDescriptorsOnce();
+  return ::protobuf_protocol_2eproto::file_level_metadata[kIndexInFileMessages];
+}
+
+
+// ===================================================================
+
+void RspBatch::InitAsDefaultInstance() {
+  ::spaceless::protocol::_RspBatch_default_instance_._instance.get_mutable()->error_ = const_cast< ::spaceless::protocol::ErrorInfo*>(
+      ::spaceless::protocol::ErrorInfo::internal_default_instance());
+}
+#if !defined(_MSC_VER) || _MSC_VER >= 1900
+const int RspBatch::kErrorFieldNumber;
+const int RspBatch::kEntryListFieldNumber;
+#endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
+
+RspBatch::RspBatch()
+  : ::google::protobuf::Message(), _internal_metadata_(NULL) {
+  ::google::protobuf::internal::InitSCC(
+      &protobuf_protocol_2eproto::scc_info_RspBatch.base);
+  SharedCtor();
+  // @@protoc_insertion_point(constructor:spaceless.protocol.RspBatch)
+}
+RspBatch::RspBatch(const RspBatch& from)
+  : ::google::protobuf::Message(),
+      _internal_metadata_(NULL),
+      entry_list_(from.entry_list_) {
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  if (from.has_error()) {
+    error_ = new ::spaceless::protocol::ErrorInfo(*from.error_);
+  } else {
+    error_ = NULL;
+  }
+  // @@protoc_insertion_point(copy_constructor:spaceless.protocol.RspBatch)
+}
+
+void RspBatch::SharedCtor() {
+  error_ = NULL;
+}
+
+RspBatch::~RspBatch() {
+  // @@protoc_insertion_point(destructor:spaceless.protocol.RspBatch)
+  SharedDtor();
+}
+
+void RspBatch::SharedDtor() {
+  if (this != internal_default_instance()) delete error_;
+}
+
+void RspBatch::SetCachedSize(int size) const {
+  _cached_size_.Set(size);
+}
+const ::google::protobuf::Descriptor* RspBatch::descriptor() {
+  ::protobuf_protocol_2eproto::protobuf_AssignDescriptorsOnce();
+  return ::protobuf_protocol_2eproto::file_level_metadata[kIndexInFileMessages].descriptor;
+}
+
+const RspBatch& RspBatch::default_instance() {
+  ::google::protobuf::internal::InitSCC(&protobuf_protocol_2eproto::scc_info_RspBatch.base);
+  return *internal_default_instance();
+}
+
+
+void RspBatch::Clear() {
+// @@protoc_insertion_point(message_clear_start:spaceless.protocol.RspBatch)
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  entry_list_.Clear();
+  if (GetArenaNoVirtual() == NULL && error_ != NULL) {
+    delete error_;
+  }
+  error_ = NULL;
+  _internal_metadata_.Clear();
+}
+
+bool RspBatch::MergePartialFromCodedStream(
+    ::google::protobuf::io::CodedInputStream* input) {
+#define DO_(EXPRESSION) if (!GOOGLE_PREDICT_TRUE(EXPRESSION)) goto failure
+  ::google::protobuf::uint32 tag;
+  // @@protoc_insertion_point(parse_start:spaceless.protocol.RspBatch)
+  for (;;) {
+    ::std::pair<::google::protobuf::uint32, bool> p = input->ReadTagWithCutoffNoLastTag(127u);
+    tag = p.first;
+    if (!p.second) goto handle_unusual;
+    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+      // .spaceless.protocol.ErrorInfo error = 1;
+      case 1: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(10u /* 10 & 0xFF */)) {
+          DO_(::google::protobuf::internal::WireFormatLite::ReadMessage(
+               input, mutable_error()));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // repeated .spaceless.protocol.BatchEntry entry_list = 2;
+      case 2: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(18u /* 18 & 0xFF */)) {
+          DO_(::google::protobuf::internal::WireFormatLite::ReadMessage(
+                input, add_entry_list()));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      default: {
+      handle_unusual:
+        if (tag == 0) {
+          goto success;
+        }
+        DO_(::google::protobuf::internal::WireFormat::SkipField(
+              input, tag, _internal_metadata_.mutable_unknown_fields()));
+        break;
+      }
+    }
+  }
+success:
+  // @@protoc_insertion_point(parse_success:spaceless.protocol.RspBatch)
+  return true;
+failure:
+  // @@protoc_insertion_point(parse_failure:spaceless.protocol.RspBatch)
+  return false;
+#undef DO_
+}
+
+void RspBatch::SerializeWithCachedSizes(
+    ::google::protobuf::io::CodedOutputStream* output) const {
+  // @@protoc_insertion_point(serialize_start:spaceless.protocol.RspBatch)
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // .spaceless.protocol.ErrorInfo error = 1;
+  if (this->has_error()) {
+    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
+      1, this->_internal_error(), output);
+  }
+
+  // repeated .spaceless.protocol.BatchEntry entry_list = 2;
+  for (unsigned int i = 0,
+      n = static_cast<unsigned int>(this->entry_list_size()); i < n; i++) {
+    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
+      2,
+      this->entry_list(static_cast<int>(i)),
+      output);
+  }
+
+  if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
+    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
+        (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), output);
+  }
+  // @@protoc_insertion_point(serialize_end:spaceless.protocol.RspBatch)
+}
+
+::google::protobuf::uint8* RspBatch::InternalSerializeWithCachedSizesToArray(
+    bool deterministic, ::google::protobuf::uint8* target) const {
+  (void)deterministic; // Unused
+  // @@protoc_insertion_point(serialize_to_array_start:spaceless.protocol.RspBatch)
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // .spaceless.protocol.ErrorInfo error = 1;
+  if (this->has_error()) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      InternalWriteMessageToArray(
+        1, this->_internal_error(), deterministic, target);
+  }
+
+  // repeated .spaceless.protocol.BatchEntry entry_list = 2;
+  for (unsigned int i = 0,
+      n = static_cast<unsigned int>(this->entry_list_size()); i < n; i++) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      InternalWriteMessageToArray(
+        2, this->entry_list(static_cast<int>(i)), deterministic, target);
+  }
+
+  if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
+    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
+        (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), target);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:spaceless.protocol.RspBatch)
+  return target;
+}
+
+size_t RspBatch::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:spaceless.protocol.RspBatch)
+  size_t total_size = 0;
+
+  if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
+    total_size +=
+      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
+        (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()));
+  }
+  // repeated .spaceless.protocol.BatchEntry entry_list = 2;
+  {
+    unsigned int count = static_cast<unsigned int>(this->entry_list_size());
+    total_size += 1UL * count;
+    for (unsigned int i = 0; i < count; i++) {
+      total_size +=
+        ::google::protobuf::internal::WireFormatLite::MessageSize(
+          this->entry_list(static_cast<int>(i)));
+    }
+  }
+
+  // .spaceless.protocol.ErrorInfo error = 1;
+  if (this->has_error()) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::MessageSize(
+        *error_);
+  }
+
+  int cached_size = ::google::protobuf::internal::ToCachedSize(total_size);
+  SetCachedSize(cached_size);
+  return total_size;
+}
+
+void RspBatch::MergeFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:spaceless.protocol.RspBatch)
+  GOOGLE_DCHECK_NE(&from, this);
+  const RspBatch* source =
+      ::google::protobuf::internal::DynamicCastToGenerated<const RspBatch>(
+          &from);
+  if (source == NULL) {
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:spaceless.protocol.RspBatch)
+    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
+  } else {
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:spaceless.protocol.RspBatch)
+    MergeFrom(*source);
+  }
+}
+
+void RspBatch::MergeFrom(const RspBatch& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:spaceless.protocol.RspBatch)
+  GOOGLE_DCHECK_NE(&from, this);
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  entry_list_.MergeFrom(from.entry_list_);
+  if (from.has_error()) {
+    mutable_error()->::spaceless::protocol::ErrorInfo::MergeFrom(from.error());
+  }
+}
+
+void RspBatch::CopyFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:spaceless.protocol.RspBatch)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void RspBatch::CopyFrom(const RspBatch& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:spaceless.protocol.RspBatch)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool RspBatch::IsInitialized() const {
+  return true;
+}
+
+void RspBatch::Swap(RspBatch* other) {
+  if (other == this) return;
+  InternalSwap(other);
+}
+void RspBatch::InternalSwap(RspBatch* other) {
+  using std::swap;
+  CastToBase(&entry_list_)->InternalSwap(CastToBase(&other->entry_list_));
+  swap(error_, other->error_);
+  _internal_metadata_.Swap(&other->_internal_metadata_);
+}
+
+::google::protobuf::Metadata RspBatch::GetMetadata() const {
+  protobuf_protocol_2eproto::protobuf_AssignDescriptorsOnce();
+  return ::protobuf_protocol_2eproto::file_level_metadata[kIndexInFileMessages];
+}
+
+
+// @@protoc_insertion_point(namespace_scope)
+}  // namespace protocol
+}  // namespace spaceless
+namespace google {
+namespace protobuf {
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::ErrorInfo* Arena::CreateMaybeMessage< ::spaceless::protocol::ErrorInfo >(Arena* arena) {
+  return Arena::CreateInternal< ::spaceless::protocol::ErrorInfo >(arena);
+}
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::RspError* Arena::CreateMaybeMessage< ::spaceless::protocol::RspError >(Arena* arena) {
+  return Arena::CreateInternal< ::spaceless::protocol::RspError >(arena);
+}
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::ReqPing* Arena::CreateMaybeMessage< ::spaceless::protocol::ReqPing >(Arena* arena) {
+  return Arena::CreateInternal< ::spaceless::protocol::ReqPing >(arena);
+}
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::RspPing* Arena::CreateMaybeMessage< ::spaceless::protocol::RspPing >(Arena* arena) {
+  return Arena::CreateInternal< ::spaceless::protocol::RspPing >(arena);
+}
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::User* Arena::CreateMaybeMessage< ::spaceless::protocol::User >(Arena* arena) {
+  return Arena::CreateInternal< ::spaceless::protocol::User >(arena);
+}
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::ReqRegisterUser* Arena::CreateMaybeMessage< ::spaceless::protocol::ReqRegisterUser >(Arena* arena) {
+  return Arena::CreateInternal< ::spaceless::protocol::ReqRegisterUser >(arena);
+}
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::RspRegisterUser* Arena::CreateMaybeMessage< ::spaceless::protocol::RspRegisterUser >(Arena* arena) {
+  return Arena::CreateInternal< ::spaceless::protocol::RspRegisterUser >(arena);
+}
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::ReqLoginUser* Arena::CreateMaybeMessage< ::spaceless::protocol::ReqLoginUser >(Arena* arena) {
+  return Arena::CreateInternal< ::spaceless::protocol::ReqLoginUser >(arena);
+}
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::RspLoginUser* Arena::CreateMaybeMessage< ::spaceless::protocol::RspLoginUser >(Arena* arena) {
+  return Arena::CreateInternal< ::spaceless::protocol::RspLoginUser >(arena);
+}
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::ReqRemoveUser* Arena::CreateMaybeMessage< ::spaceless::protocol::ReqRemoveUser >(Arena* arena) {
+  return Arena::CreateInternal< ::spaceless::protocol::ReqRemoveUser >(arena);
+}
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::RspRemoveUser* Arena::CreateMaybeMessage< ::spaceless::protocol::RspRemoveUser >(Arena* arena) {
+  return Arena::CreateInternal< ::spaceless::protocol::RspRemoveUser >(arena);
+}
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::ReqFindUser* Arena::CreateMaybeMessage< ::spaceless::protocol::ReqFindUser >(Arena* arena) {
+  return Arena::CreateInternal< ::spaceless::protocol::ReqFindUser >(arena);
+}
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::RspFindUser* Arena::CreateMaybeMessage< ::spaceless::protocol::RspFindUser >(Arena* arena) {
+  return Arena::CreateInternal< ::spaceless::protocol::RspFindUser >(arena);
+}
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::SharingGroup* Arena::CreateMaybeMessage< ::spaceless::protocol::SharingGroup >(Arena* arena) {
+  return Arena::CreateInternal< ::spaceless::protocol::SharingGroup >(arena);
+}
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::ReqRegisterGroup* Arena::CreateMaybeMessage< ::spaceless::protocol::ReqRegisterGroup >(Arena* arena) {
+  return Arena::CreateInternal< ::spaceless::protocol::ReqRegisterGroup >(arena);
+}
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::RspRegisterGroup* Arena::CreateMaybeMessage< ::spaceless::protocol::RspRegisterGroup >(Arena* arena) {
+  return Arena::CreateInternal< ::spaceless::protocol::RspRegisterGroup >(arena);
+}
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::ReqRemoveGroup* Arena::CreateMaybeMessage< ::spaceless::protocol::ReqRemoveGroup >(Arena* arena) {
+  return Arena::CreateInternal< ::spaceless::protocol::ReqRemoveGroup >(arena);
+}
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::RspRemoveGroup* Arena::CreateMaybeMessage< ::spaceless::protocol::RspRemoveGroup >(Arena* arena) {
+  return Arena::CreateInternal< ::spaceless::protocol::RspRemoveGroup >(arena);
+}
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::ReqFindGroup* Arena::CreateMaybeMessage< ::spaceless::protocol::ReqFindGroup >(Arena* arena) {
+  return Arena::CreateInternal< ::spaceless::protocol::ReqFindGroup >(arena);
 }
 template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::RspFindGroup* Arena::CreateMaybeMessage< ::spaceless::protocol::RspFindGroup >(Arena* arena) {
   return Arena::CreateInternal< ::spaceless::protocol::RspFindGroup >(arena);
@@ -14755,6 +15665,15 @@ template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::ReqRemovePa
 template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::RspRemovePath* Arena::CreateMaybeMessage< ::spaceless::protocol::RspRemovePath >(Arena* arena) {
   return Arena::CreateInternal< ::spaceless::protocol::RspRemovePath >(arena);
 }
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::BatchEntry* Arena::CreateMaybeMessage< ::spaceless::protocol::BatchEntry >(Arena* arena) {
+  return Arena::CreateInternal< ::spaceless::protocol::BatchEntry >(arena);
+}
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::ReqBatch* Arena::CreateMaybeMessage< ::spaceless::protocol::ReqBatch >(Arena* arena) {
+  return Arena::CreateInternal< ::spaceless::protocol::ReqBatch >(arena);
+}
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::spaceless::protocol::RspBatch* Arena::CreateMaybeMessage< ::spaceless::protocol::RspBatch >(Arena* arena) {
+  return Arena::CreateInternal< ::spaceless::protocol::RspBatch >(arena);
+}
 }  // namespace protobuf
 }  // namespace google
 
@@ -39,7 +39,7 @@ namespace protobuf_protocol_2eproto {
 struct TableStruct {
   static const ::google::protobuf::internal::ParseTableField entries[];
   static const ::google::protobuf::internal::AuxillaryParseTableField aux[];
-  static const ::google::protobuf::internal::ParseTable schema[47];
+  static const ::google::protobuf::internal::ParseTable schema[50];
   static const ::google::protobuf::internal::FieldMetadata field_metadata[];
   static const ::google::protobuf::internal::SerializationTable serialization_table[];
   static const ::google::protobuf::uint32 offsets[];
@@ -48,6 +48,9 @@ void AddDescriptors();
 }  // namespace protobuf_protocol_2eproto
 namespace spaceless {
 namespace protocol {
+class BatchEntry;
+class BatchEntryDefaultTypeInternal;
+extern BatchEntryDefaultTypeInternal _BatchEntry_default_instance_;
 class ErrorInfo;
 class ErrorInfoDefaultTypeInternal;
 extern ErrorInfoDefaultTypeInternal _ErrorInfo_default_instance_;
@@ -60,6 +63,9 @@ extern ReqAssignAsManagerDefaultTypeInternal _ReqAssignAsManager_default_instanc
 class ReqAssignAsMember;
 class ReqAssignAsMemberDefaultTypeInternal;
 extern ReqAssignAsMemberDefaultTypeInternal _ReqAssignAsMember_default_instance_;
+class ReqBatch;
+class ReqBatchDefaultTypeInternal;
+extern ReqBatchDefaultTypeInternal _ReqBatch_default_instance_;
 class ReqCreatePath;
 class ReqCreatePathDefaultTypeInternal;
 extern ReqCreatePathDefaultTypeInternal _ReqCreatePath_default_instance_;
@@ -123,6 +129,9 @@ extern RspAssignAsManagerDefaultTypeInternal _RspAssignAsManager_default_instanc
 class RspAssignAsMember;
 class RspAssignAsMemberDefaultTypeInternal;
 extern RspAssignAsMemberDefaultTypeInternal _RspAssignAsMember_default_instance_;
+class RspBatch;
+class RspBatchDefaultTypeInternal;
+extern RspBatchDefaultTypeInternal _RspBatch_default_instance_;
 class RspCreatePath;
 class RspCreatePathDefaultTypeInternal;
 extern RspCreatePathDefaultTypeInternal _RspCreatePath_default_instance_;
@@ -193,10 +202,12 @@ extern UserDefaultTypeInternal _User_default_instance_;
 }  // namespace spaceless
 namespace google {
 namespace protobuf {
+template<> ::spaceless::protocol::BatchEntry* Arena::CreateMaybeMessage<::spaceless::protocol::BatchEntry>(Arena*);
 template<> ::spaceless::protocol::ErrorInfo* Arena::CreateMaybeMessage<::spaceless::protocol::ErrorInfo>(Arena*);
 template<> ::spaceless::protocol::File* Arena::CreateMaybeMessage<::spaceless::protocol::File>(Arena*);
 template<> ::spaceless::protocol::ReqAssignAsManager* Arena::CreateMaybeMessage<::spaceless::protocol::ReqAssignAsManager>(Arena*);
 template<> ::spaceless::protocol::ReqAssignAsMember* Arena::CreateMaybeMessage<::spaceless::protocol::ReqAssignAsMember>(Arena*);
+template<> ::spaceless::protocol::ReqBatch* Arena::CreateMaybeMessage<::spaceless::protocol::ReqBatch>(Arena*);
 template<> ::spaceless::protocol::ReqCreatePath* Arena::CreateMaybeMessage<::spaceless::protocol::ReqCreatePath>(Arena*);
 template<> ::spaceless::protocol::ReqFindGroup* Arena::CreateMaybeMessage<::spaceless::protocol::ReqFindGroup>(Arena*);
 template<> ::spaceless::protocol::ReqFindUser* Arena::CreateMaybeMessage<::spaceless::protocol::ReqFindUser>(Arena*);
@@ -218,6 +229,7 @@ template<> ::spaceless::protocol::ReqRemovePath* Arena::CreateMaybeMessage<::spa
 template<> ::spaceless::protocol::ReqRemoveUser* Arena::CreateMaybeMessage<::spaceless::protocol::ReqRemoveUser>(Arena*);
 template<> ::spaceless::protocol::RspAssignAsManager* Arena::CreateMaybeMessage<::spaceless::protocol::RspAssignAsManager>(Arena*);
 template<> ::spaceless::protocol::RspAssignAsMember* Arena::CreateMaybeMessage<::spaceless::protocol::RspAssignAsMember>(Arena*);
+template<> ::spaceless::protocol::RspBatch* Arena::CreateMaybeMessage<::spaceless::protocol::RspBatch>(Arena*);
 template<> ::spaceless::protocol::RspCreatePath* Arena::CreateMaybeMessage<::spaceless::protocol::RspCreatePath>(Arena*);
 template<> ::spaceless::protocol::RspError* Arena::CreateMaybeMessage<::spaceless::protocol::RspError>(Arena*);
 template<> ::spaceless::protocol::RspFindGroup* Arena::CreateMaybeMessage<::spaceless::protocol::RspFindGroup>(Arena*);
@@ -247,7 +259,7 @@ namespace protocol {
 
 enum MiscellaneousType {
   INVALID_MISCELLANEOUS = 0,
-  MAX_FRAGMENT_CONTENT_LEN = 50000,
+  MAX_FRAGMENT_CONTENT_LEN = 4194304,
   MiscellaneousType_INT_MIN_SENTINEL_DO_NOT_USE_ = ::google::protobuf::kint32min,
   MiscellaneousType_INT_MAX_SENTINEL_DO_NOT_USE_ = ::google::protobuf::kint32max
 };
@@ -4096,6 +4108,12 @@ class RspPutFileSession : public ::google::protobuf::Message /* @@protoc_inserti
   ::google::protobuf::int32 next_fragment() const;
   void set_next_fragment(::google::protobuf::int32 value);
 
+  // int32 window_size = 4;
+  void clear_window_size();
+  static const int kWindowSizeFieldNumber = 4;
+  ::google::protobuf::int32 window_size() const;
+  void set_window_size(::google::protobuf::int32 value);
+
   // @@protoc_insertion_point(class_scope:spaceless.protocol.RspPutFileSession)
  private:
 
@@ -4103,6 +4121,7 @@ class RspPutFileSession : public ::google::protobuf::Message /* @@protoc_inserti
   ::spaceless::protocol::ErrorInfo* error_;
   ::google::protobuf::int32 session_id_;
   ::google::protobuf::int32 next_fragment_;
+  ::google::protobuf::int32 window_size_;
   mutable ::google::protobuf::internal::CachedSize _cached_size_;
   friend struct ::protobuf_protocol_2eproto::TableStruct;
 };
@@ -5772,6 +5791,355 @@ class RspRemovePath : public ::google::protobuf::Message /* @@protoc_insertion_p
   mutable ::google::protobuf::internal::CachedSize _cached_size_;
   friend struct ::protobuf_protocol_2eproto::TableStruct;
 };
+// -------------------------------------------------------------------
+
+class BatchEntry : public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:spaceless.protocol.BatchEntry) */ {
+ public:
+  BatchEntry();
+  virtual ~BatchEntry();
+
+  BatchEntry(const BatchEntry& from);
+
+  inline BatchEntry& operator=(const BatchEntry& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  #if LANG_CXX11
+  BatchEntry(BatchEntry&& from) noexcept
+    : BatchEntry() {
+    *this = ::std::move(from);
+  }
+
+  inline BatchEntry& operator=(BatchEntry&& from) noexcept {
+    if (GetArenaNoVirtual() == from.GetArenaNoVirtual()) {
+      if (this != &from) InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+  #endif
+  static const ::google::protobuf::Descriptor* descriptor();
+  static const BatchEntry& default_instance();
+
+  static void InitAsDefaultInstance();  // FOR INTERNAL USE ONLY
+  static inline const BatchEntry* internal_default_instance() {
+    return reinterpret_cast<const BatchEntry*>(
+               &_BatchEntry_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    47;
+
+  void Swap(BatchEntry* other);
+  friend void swap(BatchEntry& a, BatchEntry& b) {
+    a.Swap(&b);
+  }
+
+  // implements Message ----------------------------------------------
+
+  inline BatchEntry* New() const final {
+    return CreateMaybeMessage<BatchEntry>(NULL);
+  }
+
+  BatchEntry* New(::google::protobuf::Arena* arena) const final {
+    return CreateMaybeMessage<BatchEntry>(arena);
+  }
+  void CopyFrom(const ::google::protobuf::Message& from) final;
+  void MergeFrom(const ::google::protobuf::Message& from) final;
+  void CopyFrom(const BatchEntry& from);
+  void MergeFrom(const BatchEntry& from);
+  void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  bool MergePartialFromCodedStream(
+      ::google::protobuf::io::CodedInputStream* input) final;
+  void SerializeWithCachedSizes(
+      ::google::protobuf::io::CodedOutputStream* output) const final;
+  ::google::protobuf::uint8* InternalSerializeWithCachedSizesToArray(
+      bool deterministic, ::google::protobuf::uint8* target) const final;
+  int GetCachedSize() const final { return _cached_size_.Get(); }
+
+  private:
+  void SharedCtor();
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(BatchEntry* other);
+  private:
+  inline ::google::protobuf::Arena* GetArenaNoVirtual() const {
+    return NULL;
+  }
+  inline void* MaybeArenaPtr() const {
+    return NULL;
+  }
+  public:
+
+  ::google::protobuf::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  // bytes content = 2;
+  void clear_content();
+  static const int kContentFieldNumber = 2;
+  const ::std::string& content() const;
+  void set_content(const ::std::string& value);
+  #if LANG_CXX11
+  void set_content(::std::string&& value);
+  #endif
+  void set_content(const char* value);
+  void set_content(const void* value, size_t size);
+  ::std::string* mutable_content();
+  ::std::string* release_content();
+  void set_allocated_content(::std::string* content);
+
+  // int32 command = 1;
+  void clear_command();
+  static const int kCommandFieldNumber = 1;
+  ::google::protobuf::int32 command() const;
+  void set_command(::google::protobuf::int32 value);
+
+  // @@protoc_insertion_point(class_scope:spaceless.protocol.BatchEntry)
+ private:
+
+  ::google::protobuf::internal::InternalMetadataWithArena _internal_metadata_;
+  ::google::protobuf::internal::ArenaStringPtr content_;
+  ::google::protobuf::int32 command_;
+  mutable ::google::protobuf::internal::CachedSize _cached_size_;
+  friend struct ::protobuf_protocol_2eproto::TableStruct;
+};
+// -------------------------------------------------------------------
+
+class ReqBatch : public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:spaceless.protocol.ReqBatch) */ {
+ public:
+  ReqBatch();
+  virtual ~ReqBatch();
+
+  ReqBatch(const ReqBatch& from);
+
+  inline ReqBatch& operator=(const ReqBatch& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  #if LANG_CXX11
+  ReqBatch(ReqBatch&& from) noexcept
+    : ReqBatch() {
+    *this = ::std::move(from);
+  }
+
+  inline ReqBatch& operator=(ReqBatch&& from) noexcept {
+    if (GetArenaNoVirtual() == from.GetArenaNoVirtual()) {
+      if (this != &from) InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+  #endif
+  static const ::google::protobuf::Descriptor* descriptor();
+  static const ReqBatch& default_instance();
+
+  static void InitAsDefaultInstance();  // FOR INTERNAL USE ONLY
+  static inline const ReqBatch* internal_default_instance() {
+    return reinterpret_cast<const ReqBatch*>(
+               &_ReqBatch_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    48;
+
+  void Swap(ReqBatch* other);
+  friend void swap(ReqBatch& a, ReqBatch& b) {
+    a.Swap(&b);
+  }
+
+  // implements Message ----------------------------------------------
+
+  inline ReqBatch* New() const final {
+    return CreateMaybeMessage<ReqBatch>(NULL);
+  }
+
+  ReqBatch* New(::google::protobuf::Arena* arena) const final {
+    return CreateMaybeMessage<ReqBatch>(arena);
+  }
+  void CopyFrom(const ::google::protobuf::Message& from) final;
+  void MergeFrom(const ::google::protobuf::Message& from) final;
+  void CopyFrom(const ReqBatch& from);
+  void MergeFrom(const ReqBatch& from);
+  void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  bool MergePartialFromCodedStream(
+      ::google::protobuf::io::CodedInputStream* input) final;
+  void SerializeWithCachedSizes(
+      ::google::protobuf::io::CodedOutputStream* output) const final;
+  ::google::protobuf::uint8* InternalSerializeWithCachedSizesToArray(
+      bool deterministic, ::google::protobuf::uint8* target) const final;
+  int GetCachedSize() const final { return _cached_size_.Get(); }
+
+  private:
+  void SharedCtor();
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(ReqBatch* other);
+  private:
+  inline ::google::protobuf::Arena* GetArenaNoVirtual() const {
+    return NULL;
+  }
+  inline void* MaybeArenaPtr() const {
+    return NULL;
+  }
+  public:
+
+  ::google::protobuf::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  // repeated .spaceless.protocol.BatchEntry entry_list = 1;
+  int entry_list_size() const;
+  void clear_entry_list();
+  static const int kEntryListFieldNumber = 1;
+  ::spaceless::protocol::BatchEntry* mutable_entry_list(int index);
+  ::google::protobuf::RepeatedPtrField< ::spaceless::protocol::BatchEntry >*
+      mutable_entry_list();
+  const ::spaceless::protocol::BatchEntry& entry_list(int index) const;
+  ::spaceless::protocol::BatchEntry* add_entry_list();
+  const ::google::protobuf::RepeatedPtrField< ::spaceless::protocol::BatchEntry >&
+      entry_list() const;
+
+  // @@protoc_insertion_point(class_scope:spaceless.protocol.ReqBatch)
+ private:
+
+  ::google::protobuf::internal::InternalMetadataWithArena _internal_metadata_;
+  ::google::protobuf::RepeatedPtrField< ::spaceless::protocol::BatchEntry > entry_list_;
+  mutable ::google::protobuf::internal::CachedSize _cached_size_;
+  friend struct ::protobuf_protocol_2eproto::TableStruct;
+};
+// -------------------------------------------------------------------
+
+class RspBatch : public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:spaceless.protocol.RspBatch) */ {
+ public:
+  RspBatch();
+  virtual ~RspBatch();
+
+  RspBatch(const RspBatch& from);
+
+  inline RspBatch& operator=(const RspBatch& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  #if LANG_CXX11
+  RspBatch(RspBatch&& from) noexcept
+    : RspBatch() {
+    *this = ::std::move(from);
+  }
+
+  inline RspBatch& operator=(RspBatch&& from) noexcept {
+    if (GetArenaNoVirtual() == from.GetArenaNoVirtual()) {
+      if (this != &from) InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+  #endif
+  static const ::google::protobuf::Descriptor* descriptor();
+  static const RspBatch& default_instance();
+
+  static void InitAsDefaultInstance();  // FOR INTERNAL USE ONLY
+  static inline const RspBatch* internal_default_instance() {
+    return reinterpret_cast<const RspBatch*>(
+               &_RspBatch_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    49;
+
+  void Swap(RspBatch* other);
+  friend void swap(RspBatch& a, RspBatch& b) {
+    a.Swap(&b);
+  }
+
+  // implements Message ----------------------------------------------
+
+  inline RspBatch* New() const final {
+    return CreateMaybeMessage<RspBatch>(NULL);
+  }
+
+  RspBatch* New(::google::protobuf::Arena* arena) const final {
+    return CreateMaybeMessage<RspBatch>(arena);
+  }
+  void CopyFrom(const ::google::protobuf::Message& from) final;
+  void MergeFrom(const ::google::protobuf::Message& from) final;
+  void CopyFrom(const RspBatch& from);
+  void MergeFrom(const RspBatch& from);
+  void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  bool MergePartialFromCodedStream(
+      ::google::protobuf::io::CodedInputStream* input) final;
+  void SerializeWithCachedSizes(
+      ::google::protobuf::io::CodedOutputStream* output) const final;
+  ::google::protobuf::uint8* InternalSerializeWithCachedSizesToArray(
+      bool deterministic, ::google::protobuf::uint8* target) const final;
+  int GetCachedSize() const final { return _cached_size_.Get(); }
+
+  private:
+  void SharedCtor();
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(RspBatch* other);
+  private:
+  inline ::google::protobuf::Arena* GetArenaNoVirtual() const {
+    return NULL;
+  }
+  inline void* MaybeArenaPtr() const {
+    return NULL;
+  }
+  public:
+
+  ::google::protobuf::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  // repeated .spaceless.protocol.BatchEntry entry_list = 2;
+  int entry_list_size() const;
+  void clear_entry_list();
+  static const int kEntryListFieldNumber = 2;
+  ::spaceless::protocol::BatchEntry* mutable_entry_list(int index);
+  ::google::protobuf::RepeatedPtrField< ::spaceless::protocol::BatchEntry >*
+      mutable_entry_list();
+  const ::spaceless::protocol::BatchEntry& entry_list(int index) const;
+  ::spaceless::protocol::BatchEntry* add_entry_list();
+  const ::google::protobuf::RepeatedPtrField< ::spaceless::protocol::BatchEntry >&
+      entry_list() const;
+
+  // .spaceless.protocol.ErrorInfo error = 1;
+  bool has_error() const;
+  void clear_error();
+  static const int kErrorFieldNumber = 1;
+  private:
+  const ::spaceless::protocol::ErrorInfo& _internal_error() const;
+  public:
+  const ::spaceless::protocol::ErrorInfo& error() const;
+  ::spaceless::protocol::ErrorInfo* release_error();
+  ::spaceless::protocol::ErrorInfo* mutable_error();
+  void set_allocated_error(::spaceless::protocol::ErrorInfo* error);
+
+  // @@protoc_insertion_point(class_scope:spaceless.protocol.RspBatch)
+ private:
+
+  ::google::protobuf::internal::InternalMetadataWithArena _internal_metadata_;
+  ::google::protobuf::RepeatedPtrField< ::spaceless::protocol::BatchEntry > entry_list_;
+  ::spaceless::protocol::ErrorInfo* error_;
+  mutable ::google::protobuf::internal::CachedSize _cached_size_;
+  friend struct ::protobuf_protocol_2eproto::TableStruct;
+};
 // ===================================================================
 
 
@@ -7952,6 +8320,20 @@ inline void RspPutFileSession::set_next_fragment(::google::protobuf::int32 value
   // @@protoc_insertion_point(field_set:spaceless.protocol.RspPutFileSession.next_fragment)
 }
 
+// int32 window_size = 4;
+inline void RspPutFileSession::clear_window_size() {
+  window_size_ = 0;
+}
+inline ::google::protobuf::int32 RspPutFileSession::window_size() const {
+  // @@protoc_insertion_point(field_get:spaceless.protocol.RspPutFileSession.window_size)
+  return window_size_;
+}
+inline void RspPutFileSession::set_window_size(::google::protobuf::int32 value) {
+  
+  window_size_ = value;
+  // @@protoc_insertion_point(field_set:spaceless.protocol.RspPutFileSession.window_size)
+}
+
 // -------------------------------------------------------------------
 
 // ReqNodePutFileSession
@@ -9009,6 +9391,199 @@ inline void RspRemovePath::set_allocated_error(::spaceless::protocol::ErrorInfo*
   // @@protoc_insertion_point(field_set_allocated:spaceless.protocol.RspRemovePath.error)
 }
 
+// -------------------------------------------------------------------
+
+// BatchEntry
+
+// int32 command = 1;
+inline void BatchEntry::clear_command() {
+  command_ = 0;
+}
+inline ::google::protobuf::int32 BatchEntry::command() const {
+  // @@protoc_insertion_point(field_get:spaceless.protocol.BatchEntry.command)
+  return command_;
+}
+inline void BatchEntry::set_command(::google::protobuf::int32 value) {
+  
+  command_ = value;
+  // @@protoc_insertion_point(field_set:spaceless.protocol.BatchEntry.command)
+}
+
+// bytes content = 2;
+inline void BatchEntry::clear_content() {
+  content_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline const ::std::string& BatchEntry::content() const {
+  // @@protoc_insertion_point(field_get:spaceless.protocol.BatchEntry.content)
+  return content_.GetNoArena();
+}
+inline void BatchEntry::set_content(const ::std::string& value) {
+  
+  content_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value);
+  // @@protoc_insertion_point(field_set:spaceless.protocol.BatchEntry.content)
+}
+#if LANG_CXX11
+inline void BatchEntry::set_content(::std::string&& value) {
+  
+  content_.SetNoArena(
+    &::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::move(value));
+  // @@protoc_insertion_point(field_set_rvalue:spaceless.protocol.BatchEntry.content)
+}
+#endif
+inline void BatchEntry::set_content(const char* value) {
+  GOOGLE_DCHECK(value != NULL);
+  
+  content_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
+  // @@protoc_insertion_point(field_set_char:spaceless.protocol.BatchEntry.content)
+}
+inline void BatchEntry::set_content(const void* value, size_t size) {
+  
+  content_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(),
+      ::std::string(reinterpret_cast<const char*>(value), size));
+  // @@protoc_insertion_point(field_set_pointer:spaceless.protocol.BatchEntry.content)
+}
+inline ::std::string* BatchEntry::mutable_content() {
+  
+  // @@protoc_insertion_point(field_mutable:spaceless.protocol.BatchEntry.content)
+  return content_.MutableNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline ::std::string* BatchEntry::release_content() {
+  // @@protoc_insertion_point(field_release:spaceless.protocol.BatchEntry.content)
+  
+  return content_.ReleaseNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline void BatchEntry::set_allocated_content(::std::string* content) {
+  if (content != NULL) {
+    
+  } else {
+    
+  }
+  content_.SetAllocatedNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), content);
+  // @@protoc_insertion_point(field_set_allocated:spaceless.protocol.BatchEntry.content)
+}
+
+// -------------------------------------------------------------------
+
+// ReqBatch
+
+// repeated .spaceless.protocol.BatchEntry entry_list = 1;
+inline int ReqBatch::entry_list_size() const {
+  return entry_list_.size();
+}
+inline void ReqBatch::clear_entry_list() {
+  entry_list_.Clear();
+}
+inline ::spaceless::protocol::BatchEntry* ReqBatch::mutable_entry_list(int index) {
+  // @@protoc_insertion_point(field_mutable:spaceless.protocol.ReqBatch.entry_list)
+  return entry_list_.Mutable(index);
+}
+inline ::google::protobuf::RepeatedPtrField< ::spaceless::protocol::BatchEntry >*
+ReqBatch::mutable_entry_list() {
+  // @@protoc_insertion_point(field_mutable_list:spaceless.protocol.ReqBatch.entry_list)
+  return &entry_list_;
+}
+inline const ::spaceless::protocol::BatchEntry& ReqBatch::entry_list(int index) const {
+  // @@protoc_insertion_point(field_get:spaceless.protocol.ReqBatch.entry_list)
+  return entry_list_.Get(index);
+}
+inline ::spaceless::protocol::BatchEntry* ReqBatch::add_entry_list() {
+  // @@protoc_insertion_point(field_add:spaceless.protocol.ReqBatch.entry_list)
+  return entry_list_.Add();
+}
+inline const ::google::protobuf::RepeatedPtrField< ::spaceless::protocol::BatchEntry >&
+ReqBatch::entry_list() const {
+  // @@protoc_insertion_point(field_list:spaceless.protocol.ReqBatch.entry_list)
+  return entry_list_;
+}
+
+// -------------------------------------------------------------------
+
+// RspBatch
+
+// .spaceless.protocol.ErrorInfo error = 1;
+inline bool RspBatch::has_error() const {
+  return this != internal_default_instance() && error_ != NULL;
+}
+inline void RspBatch::clear_error() {
+  if (GetArenaNoVirtual() == NULL && error_ != NULL) {
+    delete error_;
+  }
+  error_ = NULL;
+}
+inline const ::spaceless::protocol::ErrorInfo& RspBatch::_internal_error() const {
+  return *error_;
+}
+inline const ::spaceless::protocol::ErrorInfo& RspBatch::error() const {
+  const ::spaceless::protocol::ErrorInfo* p = error_;
+  // @@protoc_insertion_point(field_get:spaceless.protocol.RspBatch.error)
+  return p != NULL ? *p : *reinterpret_cast<const ::spaceless::protocol::ErrorInfo*>(
+      &::spaceless::protocol::_ErrorInfo_default_instance_);
+}
+inline ::spaceless::protocol::ErrorInfo* RspBatch::release_error() {
+  // @@protoc_insertion_point(field_release:spaceless.protocol.RspBatch.error)
+  
+  ::spaceless::protocol::ErrorInfo* temp = error_;
+  error_ = NULL;
+  return temp;
+}
+inline ::spaceless::protocol::ErrorInfo* RspBatch::mutable_error() {
+  
+  if (error_ == NULL) {
+    auto* p = CreateMaybeMessage<::spaceless::protocol::ErrorInfo>(GetArenaNoVirtual());
+    error_ = p;
+  }
+  // @@protoc_insertion_point(field_mutable:spaceless.protocol.RspBatch.error)
+  return error_;
+}
+inline void RspBatch::set_allocated_error(::spaceless::protocol::ErrorInfo* error) {
+  ::google::protobuf::Arena* message_arena = GetArenaNoVirtual();
+  if (message_arena == NULL) {
+    delete error_;
+  }
+  if (error) {
+    ::google::protobuf::Arena* submessage_arena = NULL;
+    if (message_arena != submessage_arena) {
+      error = ::google::protobuf::internal::GetOwnedMessage(
+          message_arena, error, submessage_arena);
+    }
+    
+  } else {
+    
+  }
+  error_ = error;
+  // @@protoc_insertion_point(field_set_allocated:spaceless.protocol.RspBatch.error)
+}
+
+// repeated .spaceless.protocol.BatchEntry entry_list = 2;
+inline int RspBatch::entry_list_size() const {
+  return entry_list_.size();
+}
+inline void RspBatch::clear_entry_list() {
+  entry_list_.Clear();
+}
+inline ::spaceless::protocol::BatchEntry* RspBatch::mutable_entry_list(int index) {
+  // @@protoc_insertion_point(field_mutable:spaceless.protocol.RspBatch.entry_list)
+  return entry_list_.Mutable(index);
+}
+inline ::google::protobuf::RepeatedPtrField< ::spaceless::protocol::BatchEntry >*
+RspBatch::mutable_entry_list() {
+  // @@protoc_insertion_point(field_mutable_list:spaceless.protocol.RspBatch.entry_list)
+  return &entry_list_;
+}
+inline const ::spaceless::protocol::BatchEntry& RspBatch::entry_list(int index) const {
+  // @@protoc_insertion_point(field_get:spaceless.protocol.RspBatch.entry_list)
+  return entry_list_.Get(index);
+}
+inline ::spaceless::protocol::BatchEntry* RspBatch::add_entry_list() {
+  // @@protoc_insertion_point(field_add:spaceless.protocol.RspBatch.entry_list)
+  return entry_list_.Add();
+}
+inline const ::google::protobuf::RepeatedPtrField< ::spaceless::protocol::BatchEntry >&
+RspBatch::entry_list() const {
+  // @@protoc_insertion_point(field_list:spaceless.protocol.RspBatch.entry_list)
+  return entry_list_;
+}
+
 #ifdef __GNUC__
   #pragma GCC diagnostic pop
 #endif  // __GNUC__
@@ -9104,6 +9679,12 @@ inline void RspRemovePath::set_allocated_error(::spaceless::protocol::ErrorInfo*
 
 // -------------------------------------------------------------------
 
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
 
 // @@protoc_insertion_point(namespace_scope)
 
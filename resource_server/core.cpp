@@ -11,6 +11,7 @@
 #include <fstream>
 
 #include <lights/file.h>
+#include <lights/precise_time.h>
 #include <foundation/log.h>
 #include <foundation/exception.h>
 #include <foundation/delegation.h>
@@ -156,10 +157,14 @@ void User::deserialize(Object::Ptr object)
 
 UserManager::UserManager()
 {
-	TimerManager::instance()->register_frequent_timer("kick_out_offline_users",
-													  lights::PreciseTime(CHECK_OFFLINE_USERS_PER_SEC), []()
+	// Manager may be created by main thread before worker start, but timer only can be registered in worker.
+	Delegation::delegate("UserManager", Delegation::WORKER, []()
 	{
-		UserManager::instance()->kick_out_offline_users();
+		TimerManager::instance()->register_frequent_timer("kick_out_offline_users",
+														  lights::PreciseTime(CHECK_OFFLINE_USERS_PER_SEC), []()
+		{
+			UserManager::instance()->kick_out_offline_users();
+		});
 	});
 }
 
@@ -301,7 +306,7 @@ void UserManager::kick_out_user(int conn_id)
 void UserManager::heartbeat(int user_id)
 {
 	User& user = get_user(user_id);
-	user.last_hearbeat = std::time(nullptr);
+	user.last_hearbeat = lights::current_coarse_monotonic_time().seconds;
 }
 
 
@@ -314,7 +319,8 @@ bool UserManager::is_root_user(int user_id)
 
 void UserManager::kick_out_offline_users()
 {
-	std::time_t now = std::time(nullptr);
+	// Uses monotonic time to avoid kicking out all users when system time jumps.
+	std::time_t now = lights::current_coarse_monotonic_time().seconds;
 	for (auto& pair : m_login_user_list)
 	{
 		User& user = get_user(pair.second);
@@ -1218,6 +1224,57 @@ void StorageNodeManager::deserialize(Object::Ptr object)
 }
 
 
+bool PutFileSession::is_in_window(int fragment_index) const
+{
+	return fragment_index >= next_fragment &&
+		fragment_index < max_fragment &&
+		fragment_index < next_fragment + window_size;
+}
+
+
+bool PutFileSession::is_completed(int fragment_index) const
+{
+	if (fragment_index < next_fragment)
+	{
+		return true;
+	}
+	return fragment_index < max_fragment && completed_list[static_cast<std::size_t>(fragment_index)];
+}
+
+
+bool PutFileSession::is_in_flight(int fragment_index) const
+{
+	return fragment_index >= 0 &&
+		fragment_index < max_fragment &&
+		in_flight_list[static_cast<std::size_t>(fragment_index)];
+}
+
+
+void PutFileSession::set_in_flight(int fragment_index, bool in_flight)
+{
+	if (fragment_index >= 0 && fragment_index < max_fragment)
+	{
+		in_flight_list[static_cast<std::size_t>(fragment_index)] = in_flight;
+	}
+}
+
+
+void PutFileSession::complete_fragment(int fragment_index)
+{
+	if (fragment_index < 0 || fragment_index >= max_fragment)
+	{
+		return;
+	}
+
+	in_flight_list[static_cast<std::size_t>(fragment_index)] = false;
+	completed_list[static_cast<std::size_t>(fragment_index)] = true;
+	while (next_fragment < max_fragment && completed_list[static_cast<std::size_t>(next_fragment)])
+	{
+		++next_fragment;
+	}
+}
+
+
 PutFileSession& FileSessionManager::register_put_session(int user_id,
 														 int group_id,
 														 const std::string& file_path,
@@ -1227,7 +1284,8 @@ PutFileSession& FileSessionManager::register_put_session(int user_id,
 													   user_id,
 													   group_id,
 													   file_path,
-													   max_fragment);
+													   max_fragment,
+													   m_put_window);
 	++m_next_id;
 
 	Session session(SessionType::PUT_SESSION, session_entry);
@@ -1245,6 +1303,12 @@ PutFileSession& FileSessionManager::register_put_session(int user_id,
 }
 
 
+void FileSessionManager::set_put_window(int window_size)
+{
+	m_put_window = std::max(1, window_size);
+}
+
+
 GetFileSession& FileSessionManager::register_get_session(int user_id, int group_id, const std::string& file_path)
 {
 	GetFileSession* session_entry = new GetFileSession(m_next_id, user_id, group_id, file_path);
@@ -1425,9 +1489,14 @@ FileSessionManager::Session* FileSessionManager::find_session(int group_id, cons
 
 SerializationManager::SerializationManager()
 {
-	TimerManager::instance()->register_frequent_timer("SerializationManager", lights::PreciseTime(STORE_DATA_PER_SEC), []()
+	// Manager is created by main thread before worker start, but timer only can be registered in worker.
+	Delegation::delegate("SerializationManager", Delegation::WORKER, []()
 	{
-		SerializationManager::instance()->serialize();
+		TimerManager::instance()->register_frequent_timer("SerializationManager",
+														  lights::PreciseTime(STORE_DATA_PER_SEC), []()
+		{
+			SerializationManager::instance()->serialize();
+		});
 	});
 }
 
@@ -57,6 +57,9 @@ enum
 };
 
 
+const int PUT_FILE_DEFAULT_WINDOW = 16; // Default number of fragment that relay to storage node concurrently.
+
+
 using Poco::JSON::Object;
 
 
@@ -426,25 +429,66 @@ private:
 };
 
 
+/**
+ * Session of putting file. Fragments in window that start from @c next_fragment can be relayed to storage node
+ * concurrently. Completion is recorded in bitmap and @c next_fragment is advanced when all fragments before
+ * it are completed.
+ */
 struct PutFileSession
 {
-	PutFileSession(int session_id, int user_id, int group_id, const std::string file_path, int max_fragment) :
+	PutFileSession(int session_id,
+				   int user_id,
+				   int group_id,
+				   const std::string file_path,
+				   int max_fragment,
+				   int window_size) :
 		session_id(session_id),
 		user_id(user_id),
 		group_id(group_id),
 		file_path(file_path),
 		max_fragment(max_fragment),
 		next_fragment(0),
-		node_session_id(0)
+		node_session_id(0),
+		window_size(window_size),
+		in_flight_list(static_cast<std::size_t>(max_fragment), false),
+		completed_list(static_cast<std::size_t>(max_fragment), false)
 	{}
 
+	/**
+	 * Checks fragment is in window of in-flight fragment.
+	 */
+	bool is_in_window(int fragment_index) const;
+
+	/**
+	 * Checks fragment is completed.
+	 */
+	bool is_completed(int fragment_index) const;
+
+	/**
+	 * Checks fragment is relaying to storage node.
+	 */
+	bool is_in_flight(int fragment_index) const;
+
+	/**
+	 * Sets fragment is relaying to storage node or not.
+	 */
+	void set_in_flight(int fragment_index, bool in_flight);
+
+	/**
+	 * Marks fragment as completed and advances next fragment.
+	 */
+	void complete_fragment(int fragment_index);
+
 	int session_id;
 	int user_id;
 	int group_id;
 	std::string file_path;
 	int max_fragment;
-	int next_fragment;
+	int next_fragment; // All fragment before it are completed.
 	int node_session_id;
+	int window_size;
+	std::vector<bool> in_flight_list;
+	std::vector<bool> completed_list;
 };
 
 
@@ -490,6 +534,12 @@ public:
 
 	PutFileSession& register_put_session(int user_id, int group_id, const std::string& file_path, int max_fragment);
 
+	/**
+	 * Sets number of fragment that relay to storage node concurrently in each put session.
+	 * @note Only affects session that register after setting.
+	 */
+	void set_put_window(int window_size);
+
 	GetFileSession& register_get_session(int user_id, int group_id, const std::string& file_path);
 
 	void remove_session(int session_id);
@@ -514,6 +564,7 @@ private:
 	std::map<int, Session> m_session_list;
 	std::map<int, std::map<std::string, int>> m_group_session_list;
 	int m_next_id = 1;
+	int m_put_window = PUT_FILE_DEFAULT_WINDOW;
 };
 
 
@@ -4,6 +4,11 @@
 #include <foundation/scheduler.h>
 #include <foundation/log.h>
 #include <foundation/configuration.h>
+#include <foundation/actor_message.h>
+#include <foundation/worker.h>
+#include <foundation/compute_pool.h>
+#include <foundation/rsa_key_pool.h>
+#include <foundation/thread_placement.h>
 #include <protocol/all.h>
 
 #include "core.h"
@@ -22,6 +27,23 @@ int main(int argc, const char* argv[])
 		Configuration::PathList path_list = {"../configuration/resource_server_conf.json", "../configuration/global_conf.json"};
 		Configuration configuration(path_list);
 
+		// Sets worker pool. Business managers are shared by all workers, so default uses one worker.
+		WorkerScheduler::instance()->set_worker_count(configuration.getInt("worker_count", 1));
+		std::size_t batch_max_count = configuration.getUInt("worker_batch.max_count", WORKER_BATCH_MAX_COUNT);
+		int batch_max_time_us = configuration.getInt("worker_batch.max_time_us", WORKER_BATCH_MAX_TIME_US);
+		WorkerScheduler::instance()->set_batch_budget(batch_max_count, batch_max_time_us);
+		ComputePool::instance()->set_thread_count(configuration.getInt("compute_thread_count", COMPUTE_DEFAULT_THREAD_NUM));
+		RsaKeyPool::instance()->set_capacity(configuration.getUInt("rsa_key_pool_size", RSA_KEY_POOL_DEFAULT_SIZE));
+		ThreadPlacement::instance()->load(configuration);
+
+		// After scheduler start, network thread pushes to input queue and worker threads push to output queue.
+		// Compute threads push continuation to both queues, so queue is single producer only without compute thread.
+		bool has_compute_thread = ComputePool::instance()->thread_count() > 0;
+		bool has_one_worker = WorkerScheduler::instance()->worker_count() == 1;
+		ActorMessageQueue::instance()->set_single_producer(ActorMessageQueue::IN_QUEUE, !has_compute_thread);
+		ActorMessageQueue::instance()->set_single_producer(ActorMessageQueue::OUT_QUEUE,
+														   !has_compute_thread && has_one_worker);
+
 		// Sets global log level of each logger.
 		lights::LogLevel log_level = to_log_level(configuration.getString("log_level"));
 		LoggerManager::instance()->for_each([&](const std::string& name, Logger& logger) {
@@ -45,6 +67,38 @@ int main(int argc, const char* argv[])
 			}
 		}
 
+		// Overrides default priority of command.
+		for (int i = 0;; ++i)
+		{
+			std::string key_prefix = "command_priority[" + std::to_string(i) + "]";
+			std::string name;
+			std::string priority;
+			try
+			{
+				name = configuration.getString(key_prefix + ".name");
+				priority = configuration.getString(key_prefix + ".priority");
+			}
+			catch (Poco::NotFoundException& e)
+			{
+				break;  // Into array end.
+			}
+
+			try
+			{
+				protocol::set_command_priority(protocol::get_command(name), protocol::to_command_priority(priority));
+			}
+			catch (Exception& ex)
+			{
+				LIGHTS_ERROR(logger, "Invalid config {}. name={}, priority={}.", key_prefix, name, priority);
+				throw;
+			}
+		}
+
+		// Sets package memory budget. Zero means unlimited.
+		std::size_t total_budget = configuration.getUInt("package_memory_budget.total_mb", 0);
+		std::size_t connection_budget = configuration.getUInt("package_memory_budget.per_connection_mb", 0);
+		PackageManager::instance()->set_memory_budget(total_budget * 1024 * 1024, connection_budget * 1024 * 1024);
+
 		// Registers serialization.
 		SPACELESS_REG_SERIALIZATION(UserManager);
 		SPACELESS_REG_SERIALIZATION(SharingGroupManager);
@@ -100,6 +154,8 @@ int main(int argc, const char* argv[])
 			SharingGroupManager::instance()->register_group(root->user_id, root_group_name);
 		}
 
+		FileSessionManager::instance()->set_put_window(configuration.getInt("put_file_window", PUT_FILE_DEFAULT_WINDOW));
+
 		// Registers transaction.
 		using namespace transaction;
 		SPACELESS_REG_ONE_TRANS(protocol::ReqPing, on_ping);
@@ -115,9 +171,25 @@ int main(int argc, const char* argv[])
 		SPACELESS_REG_ONE_TRANS(protocol::ReqKickOutUser, on_kick_out_user);
 		SPACELESS_REG_ONE_TRANS(protocol::ReqCreatePath, on_create_path);
 		SPACELESS_REG_ONE_TRANS(protocol::ReqListFile, on_list_file);
+		SPACELESS_REG_ONE_TRANS(protocol::ReqBatch, on_batch_transaction);
+
+		// Batch entry must reply before return.
+		SPACELESS_REG_BATCH_ENTRY(protocol::ReqPing);
+		SPACELESS_REG_BATCH_ENTRY(protocol::ReqRegisterUser);
+		SPACELESS_REG_BATCH_ENTRY(protocol::ReqLoginUser);
+		SPACELESS_REG_BATCH_ENTRY(protocol::ReqRemoveUser);
+		SPACELESS_REG_BATCH_ENTRY(protocol::ReqFindUser);
+		SPACELESS_REG_BATCH_ENTRY(protocol::ReqRegisterGroup);
+		SPACELESS_REG_BATCH_ENTRY(protocol::ReqFindGroup);
+		SPACELESS_REG_BATCH_ENTRY(protocol::ReqJoinGroup);
+		SPACELESS_REG_BATCH_ENTRY(protocol::ReqAssignAsManager);
+		SPACELESS_REG_BATCH_ENTRY(protocol::ReqAssignAsMember);
+		SPACELESS_REG_BATCH_ENTRY(protocol::ReqKickOutUser);
+		SPACELESS_REG_BATCH_ENTRY(protocol::ReqCreatePath);
+		SPACELESS_REG_BATCH_ENTRY(protocol::ReqListFile);
 
 		SPACELESS_REG_MULTIPLE_TRANS(protocol::ReqPutFileSession, PutFileSessionTrans::factory);
-		SPACELESS_REG_MULTIPLE_TRANS(protocol::ReqPutFile, PutFileTrans::factory);
+		SPACELESS_REG_COROUTINE_TRANS(protocol::ReqPutFile, on_put_file);
 		SPACELESS_REG_MULTIPLE_TRANS(protocol::ReqGetFileSession, GetFileSessionTrans::factory);
 		SPACELESS_REG_MULTIPLE_TRANS(protocol::ReqGetFile, GetFileTrans::factory);
 		SPACELESS_REG_MULTIPLE_TRANS(protocol::ReqRemovePath, RemovePathTrans::factory);
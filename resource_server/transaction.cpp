@@ -333,6 +333,83 @@ void on_list_file(int conn_id, Package package)
 }
 
 
+CoroutineTask on_put_file(CoroutineTransaction& trans, int conn_id, Package package)
+{
+	User& user = UserManager::instance()->get_login_user(conn_id);
+
+	protocol::ReqPutFile request;
+	package.parse_to_protocol(request);
+
+	PutFileSession& session = FileSessionManager::instance()->get_put_session(request.session_id());
+	if (session.user_id != user.user_id)
+	{
+		SPACELESS_THROW(ERR_FILE_SESSION_NOT_REGISTER_USER);
+	}
+
+	int fragment_index = request.fragment_index();
+	int session_id = session.session_id; // Session may be removed during waiting.
+
+	// Fragment that already completed is resent when client resume putting. Only responses it.
+	if (session.is_completed(fragment_index))
+	{
+		protocol::RspPutFile response;
+		response.set_session_id(session_id);
+		response.set_fragment_index(fragment_index);
+		trans.send_back_message(response);
+		co_return;
+	}
+
+	if (!session.is_in_window(fragment_index) || session.is_in_flight(fragment_index))
+	{
+		SPACELESS_THROW(ERR_FILE_SESSION_INVALID_FRAGMENT);
+	}
+
+	protocol::ReqPutFile node_request = request;
+	node_request.set_session_id(session.node_session_id);
+	SharingGroup& group = SharingGroupManager::instance()->get_group(session.group_id);
+	StorageNode& storage_node = StorageNodeManager::instance()->get_node(group.node_id());
+	int service_id = storage_node.service_id;
+	Network::service_send_protocol(service_id, node_request, trans.transaction_id());
+	session.set_in_flight(fragment_index, true);
+
+	protocol::RspPutFile response;
+	try
+	{
+		Package node_package = co_await trans.service_next_phase(service_id, protocol::RspPutFile(), MultiplyPhaseTransaction::ADAPTIVE_TIMEOUT);
+		node_package.parse_to_protocol(response);
+	}
+	catch (...)
+	{
+		// Lets client can resend this fragment.
+		PutFileSession* waiting_session = FileSessionManager::instance()->find_put_session(session_id);
+		if (waiting_session != nullptr)
+		{
+			waiting_session->set_in_flight(fragment_index, false);
+		}
+		throw;
+	}
+
+	PutFileSession* completed_session = FileSessionManager::instance()->find_put_session(session_id);
+	if (completed_session != nullptr)
+	{
+		if (response.has_error())
+		{
+			completed_session->set_in_flight(fragment_index, false);
+		}
+		else
+		{
+			completed_session->complete_fragment(fragment_index);
+		}
+	}
+
+	// Checks login after session is updated, so fragment never stays in flight if user logout during waiting.
+	UserManager::instance()->get_login_user(conn_id);
+	response.set_session_id(session_id);
+	response.set_fragment_index(fragment_index); // Error response of node may not have it.
+	trans.send_back_message(response);
+}
+
+
 MultiplyPhaseTransaction* PutFileSessionTrans::factory(int trans_id)
 {
 	return new PutFileSessionTrans(trans_id);
@@ -402,7 +479,10 @@ void PutFileSessionTrans::on_init(int conn_id, Package package)
 
 	StorageNode& storage_node = StorageNodeManager::instance()->get_node(group.node_id());
 	Network::service_send_protocol(storage_node.service_id, storage_request, transaction_id());
-	service_wait_next_phase(storage_node.service_id, protocol::RspNodePutFileSession(), &PutFileSessionTrans::on_active);
+	service_wait_next_phase(storage_node.service_id,
+							protocol::RspNodePutFileSession(),
+							&PutFileSessionTrans::on_active,
+							ADAPTIVE_TIMEOUT);
 }
 
 
@@ -425,6 +505,7 @@ void PutFileSessionTrans::on_active(int conn_id, Package package)
 	protocol::RspPutFileSession response;
 	response.set_session_id(m_session_id);
 	response.set_next_fragment(session->next_fragment);
+	response.set_window_size(session->window_size);
 	send_back_message(response);
 }
 
@@ -436,59 +517,6 @@ void PutFileSessionTrans::on_error(int conn_id, const ErrorInfo& error_info)
 }
 
 
-MultiplyPhaseTransaction* PutFileTrans::factory(int trans_id)
-{
-	return new PutFileTrans(trans_id);
-}
-
-
-PutFileTrans::PutFileTrans(int trans_id) :
-	MultiplyPhaseTransaction(trans_id),
-	m_session_id(0)
-{}
-
-
-void PutFileTrans::on_init(int conn_id, Package package)
-{
-	User& user = UserManager::instance()->get_login_user(conn_id);
-
-	protocol::ReqPutFile request;
-	package.parse_to_protocol(request);
-
-	PutFileSession& session = FileSessionManager::instance()->get_put_session(request.session_id());
-	if (session.user_id != user.user_id)
-	{
-		SPACELESS_THROW(ERR_FILE_SESSION_NOT_REGISTER_USER);
-	}
-
-	if (request.fragment_index() != session.next_fragment)
-	{
-		SPACELESS_THROW(ERR_FILE_SESSION_INVALID_FRAGMENT);
-	}
-
-	++session.next_fragment;
-	m_session_id = session.session_id;
-
-	protocol::ReqPutFile node_request = request;
-	node_request.set_session_id(session.node_session_id);
-	SharingGroup& group = SharingGroupManager::instance()->get_group(session.group_id);
-	StorageNode& storage_node = StorageNodeManager::instance()->get_node(group.node_id());
-	Network::service_send_protocol(storage_node.service_id, node_request, transaction_id());
-	service_wait_next_phase(storage_node.service_id, protocol::RspPutFile(), &PutFileTrans::on_active);
-}
-
-
-void PutFileTrans::on_active(int conn_id, Package package)
-{
-	UserManager::instance()->get_login_user(first_connection_id());
-
-	protocol::RspPutFile response;
-	package.parse_to_protocol(response);
-	response.set_session_id(m_session_id);
-	send_back_message(response);
-}
-
-
 MultiplyPhaseTransaction* GetFileSessionTrans::factory(int trans_id)
 {
 	return new GetFileSessionTrans(trans_id);
@@ -550,7 +578,10 @@ void GetFileSessionTrans::on_init(int conn_id, Package package)
 	node_request.set_file_path(path.filename());
 	StorageNode& storage_node = StorageNodeManager::instance()->get_node(storage_file.node_id);
 	Network::service_send_protocol(storage_node.service_id, node_request, transaction_id());
-	service_wait_next_phase(storage_node.service_id, protocol::RspNodeGetFileSession(), &GetFileSessionTrans::on_active);
+	service_wait_next_phase(storage_node.service_id,
+							protocol::RspNodeGetFileSession(),
+							&GetFileSessionTrans::on_active,
+							ADAPTIVE_TIMEOUT);
 }
 
 
@@ -636,7 +667,7 @@ void GetFileTrans::on_init(int conn_id, Package package)
 	node_request.set_fragment_index(request.fragment_index());
 	StorageNode& storage_node = StorageNodeManager::instance()->get_node(storage_file.node_id);
 	Network::service_send_protocol(storage_node.service_id, node_request, transaction_id());
-	service_wait_next_phase(storage_node.service_id, protocol::RspGetFile(), &GetFileTrans::on_active);
+	service_wait_next_phase(storage_node.service_id, protocol::RspGetFile(), &GetFileTrans::on_active, ADAPTIVE_TIMEOUT);
 }
 
 
@@ -8,6 +8,7 @@
 
 #include <foundation/package.h>
 #include <foundation/transaction.h>
+#include <foundation/coroutine_transaction.h>
 #include <protocol/all.h>
 
 
@@ -43,6 +44,8 @@ void on_create_path(int conn_id, Package package);
 
 void on_list_file(int conn_id, Package package);
 
+CoroutineTask on_put_file(CoroutineTransaction& trans, int conn_id, Package package);
+
 
 class PutFileSessionTrans: public MultiplyPhaseTransaction
 {
@@ -62,22 +65,6 @@ private:
 };
 
 
-class PutFileTrans: public MultiplyPhaseTransaction
-{
-public:
-	static MultiplyPhaseTransaction* factory(int trans_id);
-
-	PutFileTrans(int trans_id);
-
-	void on_init(int conn_id, Package package) override;
-
-	void on_active(int conn_id, Package package);
-
-private:
-	int m_session_id;
-};
-
-
 class GetFileSessionTrans: public MultiplyPhaseTransaction
 {
 public:
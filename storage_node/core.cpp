@@ -6,6 +6,10 @@
 
 #include "core.h"
 
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
 #include <cmath>
 #include <algorithm>
 #include <memory>
@@ -83,6 +87,73 @@ std::size_t SharingFileManager::get_file(const std::string& filename, lights::Se
 }
 
 
+lights::Sequence SharingFileManager::read_file(const std::string& filename, std::size_t length, int start_pos)
+{
+	std::string path = get_absolute_path(filename);
+	if (!lights::env::file_exists(path.c_str()))
+	{
+		SPACELESS_THROW(ERR_FILE_NOT_EXIST);
+	}
+
+	// Writes cached data to file before read it.
+	auto itr = m_file_cache.find(path);
+	if (itr != m_file_cache.end())
+	{
+		itr->second->flush();
+	}
+
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		SPACELESS_THROW(ERR_FILE_NOT_EXIST);
+	}
+
+	struct stat file_stat;
+	auto file_size = (::fstat(fd, &file_stat) == 0) ? static_cast<std::size_t>(file_stat.st_size) : 0;
+	auto start = static_cast<std::size_t>(start_pos);
+	if (start >= file_size)
+	{
+		::close(fd);
+		return {nullptr, 0};
+	}
+
+	length = std::min(length, file_size - start);
+	std::unique_ptr<char[]> buffer(new char[length]);
+	std::size_t read_len = 0;
+	while (read_len < length)
+	{
+		ssize_t len = ::pread(fd, buffer.get() + read_len, length - read_len, static_cast<off_t>(start + read_len));
+		if (len < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		if (len < 0)
+		{
+			::close(fd);
+			SPACELESS_THROW(ERR_FILE_CANNOT_READ);
+		}
+		if (len == 0)
+		{
+			break; // File is truncated after getting size.
+		}
+		read_len += static_cast<std::size_t>(len);
+	}
+	::close(fd);
+
+	if (read_len == 0)
+	{
+		return {nullptr, 0};
+	}
+	return {buffer.release(), read_len};
+}
+
+
+void SharingFileManager::release_file(lights::Sequence file_content)
+{
+	delete[] static_cast<char*>(file_content.data());
+}
+
+
 const std::string& SharingFileManager::get_sharing_path() const
 {
 	return m_sharing_path;
@@ -145,6 +216,7 @@ FileSession& FileSessionManager::register_put_session(const std::string& filenam
 {
 	FileSession& session = register_session(filename);
 	session.max_fragment = max_fragment;
+	session.written_list.assign(static_cast<std::size_t>(std::max(0, max_fragment)), false);
 	return session;
 }
 
@@ -24,6 +24,7 @@ enum
 	ERR_FILE_ALREADY_EXIST = 1200,
 	ERR_FILE_CANNOT_CREATE = 1201,
 	ERR_FILE_NOT_EXIST = 1202,
+	ERR_FILE_CANNOT_READ = 1203,
 
 	ERR_FILE_SESSION_ALREADY_EXIST = 5000,
 	ERR_FILE_SESSION_CANNOT_CREATE = 5001,
@@ -38,12 +39,16 @@ struct FileSession
 	FileSession(int session_id, const std::string& filename) :
 		session_id(session_id),
 		filename(filename),
-		max_fragment(0)
+		max_fragment(0),
+		written_count(0),
+		written_list()
 	{}
 
 	int session_id;
 	std::string filename;
 	int max_fragment;
+	int written_count; // Fragment is written out of order, so counts it to know all fragments are written.
+	std::vector<bool> written_list;
 };
 
 
@@ -92,6 +97,19 @@ public:
 
 	std::size_t get_file(const std::string& filename, lights::Sequence file_content, int start_pos = 0);
 
+	/**
+	 * Reads part of file into new buffer that is sent as external content without copy. Returned length is
+	 * less than @c length when reach the end of file. Must call @c release_file to release it.
+	 * @note File is read instead of mapped, because sending is asynchronous and truncating mapped file
+	 *       lets sender receive SIGBUS.
+	 */
+	lights::Sequence read_file(const std::string& filename, std::size_t length, int start_pos = 0);
+
+	/**
+	 * Releases memory that return by @c read_file.
+	 */
+	static void release_file(lights::Sequence file_content);
+
 	const std::string& get_sharing_path() const;
 
 	void set_sharing_path(const std::string& sharing_path);
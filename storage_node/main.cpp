@@ -4,6 +4,10 @@
 #include <foundation/scheduler.h>
 #include <foundation/log.h>
 #include <foundation/configuration.h>
+#include <foundation/actor_message.h>
+#include <foundation/worker.h>
+#include <foundation/compute_pool.h>
+#include <foundation/thread_placement.h>
 #include <protocol/all.h>
 
 #include "core.h"
@@ -23,6 +27,22 @@ int main(int argc, const char* argv[])
 		Configuration::PathList path_list = {"../configuration/storage_node_conf.json", "../configuration/global_conf.json"};
 		Configuration configuration(path_list);
 
+		// Sets worker pool. Business managers are shared by all workers, so default uses one worker.
+		WorkerScheduler::instance()->set_worker_count(configuration.getInt("worker_count", 1));
+		std::size_t batch_max_count = configuration.getUInt("worker_batch.max_count", WORKER_BATCH_MAX_COUNT);
+		int batch_max_time_us = configuration.getInt("worker_batch.max_time_us", WORKER_BATCH_MAX_TIME_US);
+		WorkerScheduler::instance()->set_batch_budget(batch_max_count, batch_max_time_us);
+		ComputePool::instance()->set_thread_count(configuration.getInt("compute_thread_count", COMPUTE_DEFAULT_THREAD_NUM));
+		ThreadPlacement::instance()->load(configuration);
+
+		// After scheduler start, network thread pushes to input queue and worker threads push to output queue.
+		// Compute threads push continuation to both queues, so queue is single producer only without compute thread.
+		bool has_compute_thread = ComputePool::instance()->thread_count() > 0;
+		bool has_one_worker = WorkerScheduler::instance()->worker_count() == 1;
+		ActorMessageQueue::instance()->set_single_producer(ActorMessageQueue::IN_QUEUE, !has_compute_thread);
+		ActorMessageQueue::instance()->set_single_producer(ActorMessageQueue::OUT_QUEUE,
+														   !has_compute_thread && has_one_worker);
+
 		// Sets global log level of each logger.
 		lights::LogLevel log_level = to_log_level(configuration.getString("log_level"));
 		LoggerManager::instance()->for_each([&](const std::string& name, Logger& logger) {
@@ -46,6 +66,33 @@ int main(int argc, const char* argv[])
 			}
 		}
 
+		// Overrides default priority of command.
+		for (int i = 0;; ++i)
+		{
+			std::string key_prefix = "command_priority[" + std::to_string(i) + "]";
+			std::string name;
+			std::string priority;
+			try
+			{
+				name = configuration.getString(key_prefix + ".name");
+				priority = configuration.getString(key_prefix + ".priority");
+			}
+			catch (Poco::NotFoundException& e)
+			{
+				break;  // Into array end.
+			}
+
+			try
+			{
+				protocol::set_command_priority(protocol::get_command(name), protocol::to_command_priority(priority));
+			}
+			catch (Exception& ex)
+			{
+				LIGHTS_ERROR(logger, "Invalid config {}. name={}, priority={}.", key_prefix, name, priority);
+				throw;
+			}
+		}
+
 		if (argc < 4)
 		{
 			LIGHTS_ERROR(logger, "Not enough arguments to start up.");
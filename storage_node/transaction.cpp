@@ -48,19 +48,28 @@ void on_put_file(int conn_id, Package package)
 
 	FileSession& session = FileSessionManager::instance()->get_session(request.session_id());
 
-	if (request.fragment_index() >= session.max_fragment)
+	if (request.fragment_index() < 0 || request.fragment_index() >= session.max_fragment)
 	{
 		SPACELESS_THROW(ERR_FILE_SESSION_INVALID_FRAGMENT);
 	}
 
-	lights::SequenceView file_content(request.fragment_content());
-	int start_pos = request.fragment_index() * protocol::MAX_FRAGMENT_CONTENT_LEN;
-	bool is_flush = request.fragment_index() + 1 == session.max_fragment;
-	SharingFileManager::instance()->put_file(session.filename, file_content, start_pos, is_flush);
-
-	if (request.fragment_index() + 1 == session.max_fragment)
+	// Fragments arrive out of order, so flushes and removes session after all fragments are written.
+	auto index = static_cast<std::size_t>(request.fragment_index());
+	if (!session.written_list[index])
 	{
-		FileSessionManager::instance()->remove_session(session.session_id);
+		lights::SequenceView file_content(request.fragment_content());
+		int start_pos = request.fragment_index() * protocol::MAX_FRAGMENT_CONTENT_LEN;
+		bool is_flush = session.written_count + 1 == session.max_fragment;
+		SharingFileManager::instance()->put_file(session.filename, file_content, start_pos, is_flush);
+
+		// Marks as written after writing success, so fragment that write failure can be resent.
+		session.written_list[index] = true;
+		++session.written_count;
+
+		if (is_flush)
+		{
+			FileSessionManager::instance()->remove_session(session.session_id);
+		}
 	}
 
 	protocol::RspPutFile response;
@@ -103,19 +112,23 @@ void on_get_file(int conn_id, Package package)
 	protocol::RspGetFile response;
 	response.set_fragment_index(request.fragment_index());
 
-	char file_content[protocol::MAX_FRAGMENT_CONTENT_LEN];
+	// Reads file and send it as external content of package. So file content is never copied into package.
 	int start_pos = request.fragment_index() * protocol::MAX_FRAGMENT_CONTENT_LEN;
-	std::size_t content_len = SharingFileManager::instance()->get_file(session.filename,
-																	   {file_content, protocol::MAX_FRAGMENT_CONTENT_LEN},
-																	   start_pos);
-	response.set_fragment_content(file_content, content_len);
+	lights::Sequence file_content = SharingFileManager::instance()->read_file(session.filename,
+																			  protocol::MAX_FRAGMENT_CONTENT_LEN,
+																			  start_pos);
 
 	if (request.fragment_index() + 1 == session.max_fragment)
 	{
 		FileSessionManager::instance()->remove_session(session.session_id);
 	}
 
-	Network::send_back_protocol(conn_id, response, package);
+	Network::send_back_protocol_with_content(conn_id,
+											 response,
+											 package,
+											 protocol::RspGetFile::kFragmentContentFieldNumber,
+											 file_content,
+											 SharingFileManager::release_file);
 }
 
 } // namespace transaction